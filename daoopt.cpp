@@ -38,11 +38,7 @@ int main(int argc, char** argv) {
     exit(1);
   if (!main.loadProblem())
     exit(1);
-  if (!main.preprocessHeuristic())
-    exit(1);
-  if (!main.runSLS())
-    exit(1);
-  if (!main.findOrLoadOrdering())
+  if (!main.preprocess())
     exit(1);
   if (!main.initDataStructs())
     exit(1);
@@ -0,0 +1,73 @@
+/*
+ * BoundChannel.h
+ *
+ *  Copyright (C) 2008-2012 Lars Otten
+ *  This file is part of DAOOPT.
+ *
+ *  DAOOPT is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  DAOOPT is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with DAOOPT.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Lars Otten <lotten@ics.uci.edu>
+ */
+
+#ifndef BOUNDCHANNEL_H_
+#define BOUNDCHANNEL_H_
+
+#include "_base.h"
+
+/* number of leaf nodes between two polls of the channel */
+#define BOUND_POLL_INTERVAL 1000
+
+namespace daoopt {
+
+/*
+ * Channel for lower bound updates from the master to running subproblem
+ * solvers. The master sends every improvement of its global solution, the
+ * solver polls the channel periodically and passes new bounds to
+ * Search::updateGlobalBound(). Two transports are supported:
+ * - a pipe (e.g. /dev/fd/N for the local worker pool), carrying raw doubles;
+ * - a regular file (grid mode, requires a shared file system), which the
+ *   master replaces atomically and the solver re-reads on every poll.
+ */
+class BoundChannel {
+
+protected:
+  string m_path;      // Path of the channel
+  int m_fd;           // Read end of pipe (NONE for file channel)
+  double m_bound;     // Best bound received so far
+  string m_buffer;    // Incomplete data read from pipe
+
+public:
+  /* opens the channel for reading, returns false on error */
+  bool open(const string& path);
+
+  /* checks for new data, returns true iff the bound improved, in
+   * which case it is written to 'd' */
+  bool poll(double& d);
+
+  double getBound() const { return m_bound; }
+
+  /* sends a bound through a pipe, returns false on error */
+  static bool writePipe(int fd, double d);
+  /* replaces the bound in the given file, returns false on error */
+  static bool writeFile(const string& path, double d);
+
+public:
+  BoundChannel();
+  ~BoundChannel();
+};
+
+}  // namespace daoopt
+
+#endif /* BOUNDCHANNEL_H_ */
@@ -0,0 +1,118 @@
+/*
+ * ComponentSearch.h
+ *
+ *  Copyright (C) 2008-2012 Lars Otten
+ *  This file is part of DAOOPT.
+ *
+ *  DAOOPT is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  DAOOPT is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with DAOOPT.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Lars Otten <lotten@ics.uci.edu>
+ */
+
+
+#ifndef COMPONENTSEARCH_H_
+#define COMPONENTSEARCH_H_
+
+#include "_base.h"
+
+#if not (defined PARALLEL_DYNAMIC || defined PARALLEL_STATIC || defined NOTHREADS)
+
+#include "Problem.h"
+#include "Pseudotree.h"
+#include "Heuristic.h"
+#include "ProgramOptions.h"
+#include "SearchSpace.h"
+
+#include "boost/thread.hpp"
+
+namespace daoopt {
+
+/* outcome of solving a single component, see ComponentSearch */
+struct ComponentJob {
+  int root;                  // root variable of the component
+  size_t size;               // number of variables in the component
+  double value;              // optimal solution cost of the component
+#ifndef NO_ASSIGNMENT
+  vector<val_t> tuple;       // and its assignment, wrt. the component's subproblem variables
+#endif
+  SearchStats stats;         // search stats of the component
+  int depth;                 // depth of the component root in the pseudo tree
+  vector<count_t> nodeP;     // node and leaf profiles, relative
+  vector<count_t> leafP;     //   to the component root
+  ComponentJob(int r, size_t s) : root(r), size(s), value(ELEM_NAN), depth(0) {}
+};
+
+/*
+ * Solves the connected components of the problem, i.e. the subproblems below
+ * the dummy root of the pseudo tree, as independent AOBB searches in threads
+ * (--compThreads), largest component first. Each search works on its own copy
+ * of the pseudo tree, restricted to the component, and has its own search
+ * space and cache; the mini bucket tables are shared, their buckets are
+ * disjoint between components anyway. The optimal solution is the
+ * combination of the component solutions.
+ */
+class ComponentSearch {
+
+protected:
+  Problem* m_problem;
+  Pseudotree* m_pseudotree;
+  Heuristic* m_heuristic;
+  ProgramOptions* m_options;
+
+  vector<ComponentJob> m_jobs;
+  size_t m_next;          // next component to be claimed by a thread
+  boost::mutex m_mtx;     // protects m_next
+
+public:
+  /* solves all components, using up to the given number of threads */
+  void run(int threads);
+  /* claims and solves components until none are left (thread body) */
+  void work();
+
+  size_t getComponentCount() const { return m_jobs.size(); }
+  const vector<ComponentJob>& getJobs() const { return m_jobs; }
+
+  /* the cost of the combined solution, including the functions at the
+   * dummy root; NaN if a component has no solution */
+  double getSolutionCost() const;
+#ifndef NO_ASSIGNMENT
+  /* writes the combined solution as a full assignment into 'tuple' */
+  void getSolution(vector<val_t>& tuple) const;
+#endif
+
+protected:
+  /* solves a single component, in the calling thread */
+  void solve(ComponentJob& job) const;
+
+public:
+  ComponentSearch(Problem* p, Pseudotree* pt, Heuristic* h, ProgramOptions* opt);
+
+};
+
+
+/* functor to run a component thread */
+class ComponentThread {
+protected:
+  ComponentSearch* m_search;
+public:
+  void operator () () { m_search->work(); }
+  ComponentThread(ComponentSearch* s) : m_search(s) {}
+};
+
+}  // namespace daoopt
+
+#endif /* not parallel, threads */
+
+#endif /* COMPONENTSEARCH_H_ */
@@ -129,4 +129,14 @@ typedef short val_t;
 #undef PARALLEL_STATIC
 #endif
 
+/* the SLS library keeps its state in globals, these are thread local so that
+ * independent SLS instances can run in parallel threads (see SLSWrapper) */
+#if defined NOTHREADS || !defined ENABLE_SLS
+  #define SLS_TLS
+#elif defined WINDOWS
+  #define SLS_TLS __declspec(thread)
+#else
+  #define SLS_TLS __thread
+#endif
+
 #endif /* DEFS_H_ */
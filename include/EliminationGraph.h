@@ -0,0 +1,182 @@
+/*
+ * EliminationGraph.h
+ *
+ *  Copyright (C) 2008-2012 Lars Otten
+ *  This file is part of DAOOPT.
+ *
+ *  DAOOPT is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  DAOOPT is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with DAOOPT.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Lars Otten <lotten@ics.uci.edu>
+ */
+
+#ifndef ELIMINATIONGRAPH_H_
+#define ELIMINATIONGRAPH_H_
+
+#include "_base.h"
+#include "Graph.h"
+
+namespace daoopt {
+
+/* bit operations on 64 bit words */
+inline int popcount64(uint64_t w) {
+#ifdef __GNUC__
+  return __builtin_popcountll(w);
+#else
+  int c = 0;
+  for (; w; ++c) w &= w - 1;
+  return c;
+#endif
+}
+
+inline int lowestBit64(uint64_t w) {
+  assert(w);
+#ifdef __GNUC__
+  return __builtin_ctzll(w);
+#else
+  int c = 0;
+  for (; !(w & 1); ++c) w >>= 1;
+  return c;
+#endif
+}
+
+
+/*
+ * Compact primal graph for repeated randomized min-fill elimination. Adjacency
+ * is stored as dense bitset rows, min-fill scores are maintained incrementally
+ * as edges are added and nodes removed, and nodes are kept in an indexed binary
+ * heap ordered by (score, index). All arrays are allocated once in the
+ * constructor; each call to eliminate() restores the initial state in place.
+ *
+ * eliminate() yields the same orderings as Pseudotree::eliminate() (with zero
+ * tolerance) for the same random number sequence: the heap keys are only
+ * updated at the points where the latter recomputes scores, i.e. for the
+ * nodes within distance two of a (non-simplicial) eliminated node.
+ *
+ * Besides the induced width, an additional ordering objective (see _base.h)
+ * can be accumulated as nodes are eliminated, which allows early termination
+ * against a cost limit as well:
+ * - state space: sum over all clusters of the product of domain sizes;
+ * - cache bytes: estimated size of the AND/OR cache tables under the given
+ *   cache bound, where for adaptively cached nodes the context instantiations
+ *   are bounded by the product of the largest domain sizes in the context;
+ * - height: height of the implied pseudo tree.
+ */
+class EliminationGraph {
+
+protected:
+  typedef uint64_t word_t;
+
+  int m_n;                      // number of nodes (ids 0..n-1)
+  size_t m_words;               // words per bitset row
+
+  vector<word_t> m_adjInit;     // initial adjacency bitsets
+  vector<int> m_degreeInit;     // initial node degrees
+  vector<nCost> m_scoreInit;    // initial minfill scores
+  vector<bool> m_present;       // node exists in the graph
+
+  vector<word_t> m_adj;         // current adjacency bitsets, row i at i*m_words
+  vector<int> m_degree;         // current node degrees
+  vector<nCost> m_score;        // current (exact) minfill scores
+  int m_remaining;              // number of nodes not yet eliminated
+
+  vector<nCost> m_key;          // heap keys (scores as seen by the ordering)
+  vector<int> m_heap;           // binary heap of node ids
+  vector<int> m_pos;            // position of each node in heap (NONE if not in it)
+  int m_heapSize;
+
+  vector<int> m_nbr;            // scratch: neighbors of eliminated node
+  vector<int> m_update;         // scratch: nodes whose heap keys are refreshed
+  vector<int> m_ties;           // scratch: minimal-key nodes
+  vector<int> m_mark;           // scratch: marks for m_update
+  int m_stamp;
+
+  int m_objective;              // ordering objective, ORDER_OBJ_* in _base.h
+  int m_cbound;                 // cache bound for ORDER_OBJ_CACHE
+  vector<double> m_domain;      // domain sizes of the nodes
+  vector<int> m_subHeight;      // height of pseudo tree below each node so far
+  vector<double> m_ctxDomains;  // scratch: context domain sizes
+  double m_cost;                // objective value of current elimination
+
+public:
+  /* computes an elimination order into 'elim' and returns its induced width,
+   * or INT_MAX if it exceeds 'limit'. Random tie breaking uses 'rs' if given,
+   * the global random number generator otherwise */
+  int eliminate(vector<int>& elim, int limit = INT_MAX, RandStream* rs = NULL,
+                double costLimit = numeric_limits<double>::infinity());
+
+  /* eliminates along the given ordering, returns its induced width */
+  int evaluate(const vector<int>& elim);
+
+  /* sets the ordering objective to accumulate */
+  void setObjective(int objective, const vector<val_t>& domains, int cbound);
+
+  /* objective value of the last elimination (0 for ORDER_OBJ_WIDTH) */
+  double getCost() const { return m_cost; }
+
+  int getN() const { return m_n; }
+
+protected:
+  /* restores the initial graph, scores and heap */
+  void reset();
+
+  /* adds edge (i,j), updates the scores of i, j and their common neighbors */
+  void addEdge(int i, int j);
+  /* removes node i and its edges, updates the scores of its neighbors */
+  void removeNode(int i);
+
+  /* writes the neighbors of i into m_nbr and adds the objective
+   * contribution of eliminating i to m_cost */
+  void account(int i);
+  /* connects all nodes in m_nbr */
+  void connectNeighbors();
+
+  /* writes the neighbors of i into out */
+  void getNeighbors(int i, vector<int>& out) const;
+  /* number of common neighbors of i and j */
+  int commonNeighbors(int i, int j) const;
+
+  /* heap operations */
+  bool heapLess(int a, int b) const;
+  void heapUp(int p);
+  void heapDown(int p);
+  void heapRemove(int i);
+  void heapUpdate(int i);
+  /* collects all nodes with the heap's minimal key into m_ties, sorted by index */
+  void collectTies();
+
+public:
+  EliminationGraph(Graph G);
+
+};
+
+
+/* Inline definitions */
+
+inline bool EliminationGraph::heapLess(int a, int b) const {
+  return m_key[a] < m_key[b] || (m_key[a] == m_key[b] && a < b);
+}
+
+inline int EliminationGraph::commonNeighbors(int i, int j) const {
+  const word_t* a = &m_adj[i*m_words];
+  const word_t* b = &m_adj[j*m_words];
+  int c = 0;
+  for (size_t k = 0; k < m_words; ++k)
+    c += popcount64(a[k] & b[k]);
+  return c;
+}
+
+}  // namespace daoopt
+
+#endif /* ELIMINATIONGRAPH_H_ */
@@ -0,0 +1,133 @@
+/*
+ * IterativeLDS.h
+ *
+ *  Copyright (C) 2008-2012 Lars Otten
+ *  This file is part of DAOOPT.
+ *
+ *  DAOOPT is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  DAOOPT is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with DAOOPT.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Lars Otten <lotten@ics.uci.edu>
+ */
+
+#ifndef ITERATIVELDS_H_
+#define ITERATIVELDS_H_
+
+#include "_base.h"
+
+#ifndef NOTHREADS
+
+#include "Problem.h"
+#include "Pseudotree.h"
+#include "Heuristic.h"
+#include "ProgramOptions.h"
+#include "SearchSpace.h"
+#include "LimitedDiscrepancy.h"
+
+#include "boost/thread.hpp"
+
+namespace daoopt {
+
+/*
+ * Iterative limited discrepancy search (--ldsThreads, --ldsTime): runs LDS
+ * with discrepancy limits 0,1,..,--lds, each in its own search space, with
+ * the limits handed out to a number of threads in increasing order. The
+ * best solution found is shared as incumbent for pruning by all instances;
+ * everything stops once the time budget is exhausted.
+ */
+class IterativeLDS {
+
+protected:
+  Problem* m_problem;
+  Pseudotree* m_pseudotree;
+  Heuristic* m_heuristic;
+  ProgramOptions* m_options;
+
+  int m_maxDisc;          // highest discrepancy limit
+  time_t m_timeStart;
+
+  /* shared state, protected by m_mtx */
+  int m_nextDisc;         // next discrepancy limit to be claimed by a thread
+  int m_doneDisc;         // no. of limits (from 0) whose LDS ran to completion
+  vector<bool> m_done;    // limits whose LDS ran to completion
+  bool m_stop;            // time budget exhausted (or error)
+  double m_bound;         // the shared incumbent, updates are reported to the problem
+#ifndef NO_ASSIGNMENT
+  vector<val_t> m_tuple;
+#endif
+  size_t m_boundVersion;  // counts incumbent updates, for cheap polling
+  count_t m_numOR;        // nodes expanded by all instances
+  count_t m_numAND;
+  boost::mutex m_mtx;
+
+public:
+  /* runs the LDS instances in the given number of threads, starting from the
+   * problem's current solution */
+  void run(int threads);
+  /* claims and runs discrepancy limits until none are left (thread body) */
+  void work();
+
+  double getCurOptValue() const { return m_bound; }
+  /* returns the number of limits (from 0) whose LDS ran to completion,
+   * i.e. all solutions with less discrepancies have been considered */
+  int getCompleted() const { return m_doneDisc; }
+  count_t getNumExpOR() const { return m_numOR; }
+  count_t getNumExpAND() const { return m_numAND; }
+
+protected:
+  /* runs LDS with the given limit, returns false if stopped early */
+  bool runLimit(int disc);
+  /* reports a solution found by an instance, returns true if it improved the
+   * incumbent */
+  bool report(double d,
+#ifndef NO_ASSIGNMENT
+              const vector<val_t>& tuple,
+#endif
+              const SearchStats* stats);
+  /* applies the incumbent to the instance if it is newer than 'version',
+   * returns false if the time budget is exhausted */
+  bool poll(Search& lds, size_t& version);
+
+public:
+  IterativeLDS(Problem* p, Pseudotree* pt, Heuristic* h, ProgramOptions* opt);
+  ~IterativeLDS() {}
+
+};
+
+
+/* functor to run a thread of the iterative LDS */
+class IterativeLDSThread {
+protected:
+  IterativeLDS* m_lds;
+public:
+  void operator () () { m_lds->work(); }
+  IterativeLDSThread(IterativeLDS* lds) : m_lds(lds) {}
+};
+
+
+/* Inline definitions */
+
+inline IterativeLDS::IterativeLDS(Problem* p, Pseudotree* pt, Heuristic* h, ProgramOptions* opt) :
+    m_problem(p), m_pseudotree(pt), m_heuristic(h), m_options(opt),
+    m_maxDisc(opt->lds), m_nextDisc(0), m_doneDisc(0), m_done(opt->lds + 1, false),
+    m_stop(false), m_bound(ELEM_NAN), m_boundVersion(0), m_numOR(0), m_numAND(0) {
+  assert(p && pt && h && opt && opt->lds >= 0);
+  time(&m_timeStart);
+}
+
+}  // namespace daoopt
+
+#endif /* NOTHREADS */
+
+#endif /* ITERATIVELDS_H_ */
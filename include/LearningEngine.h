@@ -40,27 +40,63 @@ protected:
 public:
   /* Adds a subproblem (i.e. its stats) to the learning set */
   void addSample(const SubproblemStats& sample) { m_samples.push_back(sample); }
+  size_t getSampleCount() const { return m_samples.size(); }
 
   /* Trains the model */
   virtual bool trainModel() = 0;
 
   /* Uses the trained model to predict the complexity of the subproblem
-   * with the given stats */
+   * with the given stats (log10 of the number of AND nodes) */
   virtual double predict(const SubproblemStats&) const = 0;
 
+  /* True iff a model was trained or loaded */
+  virtual bool isTrained() const = 0;
+
+  /* Writes the trained model to / reads a model from file */
+  virtual bool modelToFile(const string& fn) const = 0;
+  virtual bool modelFromFile(const string& fn) = 0;
+
+  /* Prediction error on the learning set (in log10 space) */
+  virtual string errorReport() const;
+
   /* Prints subproblem stats to file (with column titles) */
   void statsToFile(const string& fn) const;
 
+  /* The prediction target for a given subproblem */
+  static double target(const SubproblemStats& s) { return log10(max(1.0, (double) s.subNodeCount)); }
+
   LearningEngine(ProgramOptions* opt) : m_options(opt) {}
   virtual ~LearningEngine() {};
 
 };
 
+/*
+ * Ridge regression of log10 subproblem size over the features given by
+ * SubproblemStats::getFeatures(). Features are standardized using their
+ * mean and standard deviation on the learning set, the regularization
+ * weight is given by --learnreg.
+ */
 class LinearRegressionLearner : public LearningEngine {
+protected:
+  double m_lambda;              // regularization weight
+  double m_intercept;           // model intercept (mean target value)
+  vector<double> m_mean;        // per-feature mean
+  vector<double> m_scale;       // per-feature standard deviation (0: unused)
+  vector<double> m_weight;      // per-feature weight on standardized value
+  vector<double> m_looResidual; // leave-one-out residuals on learning set
+
+  /* standardizes the features of the given sample into 'out' */
+  void standardize(const SubproblemStats& s, vector<double>& out) const;
+
 public:
-  bool trainModel() { return false; }  // TODO
-  double predict(const SubproblemStats&) const { return 0.0; }  // TODO
-  LinearRegressionLearner(ProgramOptions* opt) : LearningEngine(opt) {}
+  bool trainModel();
+  double predict(const SubproblemStats&) const;
+  bool isTrained() const { return !m_weight.empty(); }
+  bool modelToFile(const string& fn) const;
+  bool modelFromFile(const string& fn);
+  string errorReport() const;
+  LinearRegressionLearner(ProgramOptions* opt) :
+    LearningEngine(opt), m_lambda(opt->learnRegularization), m_intercept(0.0) {}
 };
 
 }  // namespace daoopt
@@ -29,6 +29,9 @@
 #include "Problem.h"
 #include "Function.h"
 #include "Graph.h"
+#include "BoundChannel.h"
+#include "OrderingCache.h"
+#include "OrderingSearch.h"
 #include "Pseudotree.h"
 #include "ProgramOptions.h"
 #include "MiniBucketElim.h"
@@ -50,20 +53,38 @@
   #include "BranchAndBound.h"
   #include "BranchAndBoundRotate.h"
   #include "BoundPropagator.h"
+  #include "Portfolio.h"
+  #include "ComponentSearch.h"
 #endif
 
 #include "BestFirst.h"
 #include "LimitedDiscrepancy.h"
+#include "IterativeLDS.h"
 
 namespace daoopt {
 
 class Main {
 protected:
   bool m_solved;
+  vector<bool> m_splitOpen;  // open root values of a subproblem stopped for re-splitting
+  string m_batchFile;        // subproblem file of a batch (worker mode)
+  vector<int> m_batch;       // subproblem ids of a batch, solved one after another
+  int m_subprobId;           // id of a single subproblem (NONE if not given)
   scoped_ptr<ProgramOptions> m_options;
   scoped_ptr<Problem> m_problem;
   scoped_ptr<Pseudotree> m_pseudotree;
   scoped_ptr<Heuristic> m_heuristic;
+
+  /* state of the ordering stage, see findOrLoadOrdering() */
+  scoped_ptr<Graph> m_graph;               // primal graph of the reduced problem
+  scoped_ptr<ARE::Graph> m_cvoGraph;       // preprocessed graph for CVO (if used)
+  scoped_ptr<OrderingCache> m_orderCache;  // persistent ordering cache (if used)
+  scoped_ptr<Pseudotree> m_orderTree;      // pseudo tree of the ordering found
+  string m_orderLog;                       // deferred output of the ordering search
+
+#if not (defined PARALLEL_DYNAMIC || defined PARALLEL_STATIC || defined NOTHREADS)
+  scoped_ptr<Portfolio> m_portfolio;  // declared first, outlives the winning search below
+#endif
 #ifdef ENABLE_SLS
   scoped_ptr<SLSWrapper> m_slsWrapper;
 #endif
@@ -84,6 +105,30 @@ protected:
   bool runSearchDynamic();
   bool runSearchStatic();
   bool runSearchWorker();
+  /* solves the current (sub)problem, polling the master for bound updates */
+  void searchSubproblem(BoundChannel* boundUpdates, double& bound, size_t& updates);
+  /* solves the subproblems of a batch in turn, reusing the preprocessing */
+  bool searchBatch(BoundChannel* boundUpdates, double& bound, size_t& updates);
+#if defined ENABLE_SLS && !defined NOTHREADS
+  /* exchanges solutions with SLS running concurrently (--slsLive), the last
+   * one handed to SLS is kept in slsBound */
+  void exchangeSLS(double& slsBound);
+#endif
+#if not (defined PARALLEL_DYNAMIC || defined PARALLEL_STATIC || defined NOTHREADS)
+  /* runs the search portfolio (--portfolio), the search that finished first
+   * replaces m_search / m_space for the output */
+  bool searchPortfolio();
+  /* solves the problem components as independent searches (--compThreads),
+   * reports the combined solution */
+  bool searchComponents();
+#endif
+#ifndef NOTHREADS
+  /* runs LDS iteratively with limits 0..--lds in threads (--ldsThreads,
+   * --ldsTime), called from runLDS() */
+  bool runIterativeLDS();
+#endif
+  /* true iff the subproblem budget (--split-time/--split-nodes) is exhausted */
+  bool splitBudgetExceeded(time_t timeStart) const;
 
   static Heuristic* newHeuristic(Problem*, Pseudotree*, ProgramOptions*);
 
@@ -92,7 +137,20 @@ public:
   bool parseOptions(int argc, char** argv);
   bool outputInfo() const;
   bool loadProblem();
+  /* runs heuristic preprocessing, SLS and the ordering search; unless
+   * --nopipeline is given, the ordering search runs in its own thread,
+   * concurrently with the other two */
+  bool preprocess();
   bool findOrLoadOrdering();
+  /* the stages of findOrLoadOrdering(): prepareOrdering() builds the graphs
+   * from the function scopes, searchOrdering() finds or loads the ordering
+   * without accessing the problem functions (so they can be replaced in the
+   * meantime, e.g. by MPLP), finishOrdering() installs the pseudo tree and
+   * syncs it with the functions. With 'quiet', the output of searchOrdering()
+   * is deferred to finishOrdering() */
+  bool prepareOrdering();
+  bool searchOrdering(bool quiet = false);
+  bool finishOrdering();
   bool runSLS();
   bool initDataStructs();
   bool preprocessHeuristic();
@@ -105,14 +163,24 @@ public:
   bool isSolved() const { return m_solved; }
 
   Main();
+  ~Main();
 
 };
 
-/* Inline implementations */
 
-inline Main::Main() : m_solved(false) {
-  /* nothing here */
-}
+#ifndef NOTHREADS
+/* functor to run the ordering search in its own thread, see Main::preprocess() */
+class OrderingStageThread {
+protected:
+  Main* m_main;
+  bool* m_success;
+public:
+  void operator () () { *m_success = m_main->searchOrdering(true); }
+  OrderingStageThread(Main* m, bool* success) : m_main(m), m_success(success) {}
+};
+#endif
+
+/* Inline implementations */
 
 inline bool Main::runSearch() {
   if (m_options->nosearch)
@@ -0,0 +1,65 @@
+/*
+ * OrderingCache.h
+ *
+ *  Copyright (C) 2008-2012 Lars Otten
+ *  This file is part of DAOOPT.
+ *
+ *  DAOOPT is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  DAOOPT is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with DAOOPT.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Lars Otten <lotten@ics.uci.edu>
+ */
+
+#ifndef ORDERINGCACHE_H_
+#define ORDERINGCACHE_H_
+
+#include "_base.h"
+#include "Problem.h"
+
+namespace daoopt {
+
+/*
+ * On-disk cache of elimination orderings across runs. Each entry is a small
+ * text file in the cache directory, named by the structural fingerprint of
+ * the (reduced) problem, holding the best ordering found so far together with
+ * its induced width, pseudo tree height and objective value. Orderings for
+ * objectives other than the width are kept in separate entries. Entries are
+ * only ever replaced by better orderings.
+ */
+class OrderingCache {
+
+protected:
+  const Problem* m_problem;   // The problem instance
+  int m_objective;            // The ordering objective, ORDER_OBJ_* in _base.h
+  string m_filename;          // Path of the cache entry for this problem
+
+public:
+  /* reads the cached ordering into 'elim' with its width, height and
+   * objective value, returns false if there is no (valid) entry */
+  bool load(vector<int>& elim, int& width, int& height, double& cost) const;
+
+  /* stores the ordering if it improves on the cached one (or there is none),
+   * returns true in that case */
+  bool save(const vector<int>& elim, int width, int height, double cost = 0.0) const;
+
+  const string& getFilename() const { return m_filename; }
+
+public:
+  OrderingCache(const string& dir, const Problem* p, int objective = ORDER_OBJ_WIDTH);
+
+};
+
+}  // namespace daoopt
+
+#endif /* ORDERINGCACHE_H_ */
@@ -0,0 +1,154 @@
+/*
+ * OrderingSearch.h
+ *
+ *  Copyright (C) 2008-2012 Lars Otten
+ *  This file is part of DAOOPT.
+ *
+ *  DAOOPT is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  DAOOPT is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with DAOOPT.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Lars Otten <lotten@ics.uci.edu>
+ */
+
+#ifndef ORDERINGSEARCH_H_
+#define ORDERINGSEARCH_H_
+
+#include "_base.h"
+#include "Graph.h"
+#include "EliminationGraph.h"
+#include "Problem.h"
+#include "ProgramOptions.h"
+#include "Pseudotree.h"
+
+#ifndef NOTHREADS
+#include "boost/thread.hpp"
+#endif
+
+/* forward declaration */
+namespace ARE {
+  class Graph;
+}
+
+namespace daoopt {
+
+/*
+ * Randomized search for a variable elimination ordering, looking for minimal
+ * induced width and breaking ties via pseudo tree height. Alternatively, a
+ * different objective can be minimized first (--orderObjective, ORDER_OBJ_*
+ * in _base.h), with width and height as tie breakers. Independent attempts
+ * can be run in several threads, each with its own random number stream; the
+ * best width found so far is shared and used by all threads as limit for early
+ * termination of worse orderings.
+ */
+class OrderingSearch {
+
+protected:
+  Problem* m_problem;             // The problem instance
+  ProgramOptions* m_options;      // Program options (iteration/time limits etc.)
+  const Graph& m_graph;           // Primal graph of the problem
+  const ARE::Graph* m_cvoMaster;  // Preprocessed graph for CVO (NULL if not used)
+
+  vector<int> m_elim;             // Best ordering found so far
+  int m_width;                    // Induced width of best ordering
+  int m_height;                   // Pseudo tree height of best ordering
+  double m_cost;                  // Objective value of best ordering
+
+  int m_iterCount;                // Number of iterations started
+  int m_sinceLast;                // Iterations since last improvement
+  int m_remaining;                // Remaining iterations (can be extended adaptively)
+  time_t m_timeStart;             // Start time of the search
+  bool m_quiet;                   // No progress output on improvements
+
+#ifndef NOTHREADS
+  boost::mutex m_mtx;             // Protects the shared state above
+#endif
+
+public:
+  /* sets a known ordering (e.g. from file) as starting point */
+  void setOrdering(const vector<int>& elim, int width, int height);
+
+  /* suppresses the progress output, e.g. when running concurrently
+   * with other preprocessing */
+  void setQuiet(bool quiet) { m_quiet = quiet; }
+
+  /* runs the ordering search with the given number of threads */
+  void run(int threads);
+
+  const vector<int>& getOrdering() const { return m_elim; }
+  int getWidth() const { return m_width; }
+  int getHeight() const { return m_height; }
+  double getCost() const { return m_cost; }
+  int getIterations() const { return m_iterCount; }
+
+  /* performs ordering iterations until the limits are reached, random
+   * choices use 'rs' if given, the global random number generator otherwise */
+  void work(RandStream* rs);
+
+protected:
+  /* claims the next iteration, returns its index or NONE if the search
+   * is done; 'limit' and 'costLimit' are set to the limits for early
+   * termination of the elimination, according to the objective */
+  int nextIteration(int& limit, double& costLimit);
+
+  /* reports the result of iteration 'iter', updates the best ordering
+   * if appropriate and returns true in that case */
+  bool reportOrdering(int iter, const vector<int>& elim, int width, int height, double cost);
+
+  /* true iff (cost, width, height) is better than the current best */
+  bool isBetter(int width, int height, double cost) const;
+
+public:
+  OrderingSearch(Problem* p, ProgramOptions* opt, const Graph& g, const ARE::Graph* cvo = NULL);
+
+};
+
+
+#ifndef NOTHREADS
+/* functor to run a single ordering thread, using its own random seed */
+class OrderingThread {
+protected:
+  OrderingSearch* m_search;
+  int m_seed;
+public:
+  void operator () () {
+    RandStream rs(m_seed);
+    m_search->work(&rs);
+  }
+  OrderingThread(OrderingSearch* s, int seed) : m_search(s), m_seed(seed) {}
+};
+#endif
+
+
+/* Inline definitions */
+
+inline OrderingSearch::OrderingSearch(Problem* p, ProgramOptions* opt, const Graph& g,
+                                      const ARE::Graph* cvo) :
+    m_problem(p), m_options(opt), m_graph(g), m_cvoMaster(cvo),
+    m_width(numeric_limits<int>::max()), m_height(numeric_limits<int>::max()),
+    m_cost(numeric_limits<double>::infinity()),
+    m_iterCount(0), m_sinceLast(0), m_remaining(opt->order_iterations), m_timeStart(0), m_quiet(false) {
+  assert(p && opt);
+}
+
+inline bool OrderingSearch::isBetter(int width, int height, double cost) const {
+  if (m_options->order_objective != ORDER_OBJ_WIDTH) {
+    if (cost != m_cost)
+      return cost < m_cost;
+  }
+  return width < m_width || (width == m_width && height < m_height);
+}
+
+}  // namespace daoopt
+
+#endif /* ORDERINGSEARCH_H_ */
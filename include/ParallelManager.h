@@ -34,10 +34,32 @@
 #include "BranchAndBoundSampler.h"
 #include "BoundPropagator.h"
 #include "LearningEngine.h"
+#include "ResultLog.h"
 #include "utils.h"
 
+#include "boost/thread.hpp"
+
 namespace daoopt {
 
+/* AOBB lookahead for a single frontier candidate, run in its own search
+ * space: the candidate's context assignment and PST are recorded in the
+ * master beforehand, the outcome is merged back in candidate order */
+struct LookaheadJob {
+  SearchNode* node;          // the candidate OR node in the master search space
+  vector<val_t> assig;       // context assignment of the candidate
+  vector<double> pst;        // partial solution tree above it (top-down)
+  bool complete;             // true iff the lookahead solved the subproblem
+  double value;              // best subproblem solution found (optimal if complete)
+#ifndef NO_ASSIGNMENT
+  vector<val_t> tuple;       // and its assignment
+#endif
+  SearchStats stats;         // search stats of the lookahead
+  vector<count_t> nodeP;     // node and leaf profiles, relative to
+  vector<count_t> leafP;     //   the candidate's depth
+  LookaheadJob(SearchNode* n) : node(n), complete(false), value(ELEM_NAN) {}
+};
+
+
 class ParallelManager : virtual public Search {
 
 protected:
@@ -70,6 +92,15 @@ protected:
   /* for propagating leaf nodes */
   BoundPropagator m_prop;
 
+  /* external results already parsed while the local pool was running,
+   * with the respective node counts (empty if results are read from files) */
+  vector<bool> m_extParsed;
+  vector<pair<count_t, count_t> > m_extCounts;
+
+  /* next lookahead job to be claimed by a thread */
+  size_t m_nextLookahead;
+  boost::mutex m_mtxLookahead;
+
 protected:
   /* implemented from Search class */
   bool isDone() const;
@@ -81,6 +112,27 @@ protected:
 protected:
   /* moves the frontier one step deeper by splitting the given node */
   bool deepenFrontier(SearchNode*, vector<SearchNode*>& out);
+  /* expands the (dummy) AND node the frontier starts from into its OR
+   * children; returns true if there are none */
+  bool expandStartAND(SearchNode*, vector<SearchNode*>& out);
+  /* generates the OR children of the given AND node, as part of the frontier;
+   * children solved right away are propagated (deleting no node above
+   * upperLimit), easy ones are put in m_local, the others into out. Returns
+   * true if there are no children */
+  bool expandFrontierAND(SearchNode*, vector<SearchNode*>& out, SearchNode* upperLimit = NULL);
+  /* same for several AND nodes at once, the AOBB lookahead of all their OR
+   * children is run in parallel (--lookahead-threads) */
+  void expandFrontierAND(const vector<SearchNode*>&, vector<SearchNode*>& out,
+                         SearchNode* upperLimit = NULL);
+  /* re-splits external subproblem 'id', whose worker stopped early with the
+   * given best solution and open root values: finished values are closed,
+   * the others are expanded into new external subproblems (appended to
+   * m_external). Returns the number of new subproblems */
+  size_t resplitSubproblem(size_t id, double value,
+#ifndef NO_ASSIGNMENT
+                           const vector<val_t>& tuple,
+#endif
+                           const vector<bool>& open);
   /* evaluates a node (wrt. order in the queue) */
   double evaluate(SearchNode*) const;
   /* filters out easy subproblems */
@@ -93,6 +145,17 @@ protected:
    * below node (max. nodeLimit expansions); returns true if subproblem
    * was solved */
   bool applyAOBB(SearchNode* node, count_t nodeLimit);
+  /* applies the AOBB lookahead to several subproblems at once, using up to
+   * --lookahead-threads threads, each with its own BranchAndBound instance
+   * and search space; jobs[i] holds the outcome for nodes[i] */
+  void applyAOBB(const vector<SearchNode*>& nodes, count_t nodeLimit,
+                 vector<LookaheadJob>& jobs);
+  /* runs the lookahead for a single job, in the calling thread */
+  void runLookahead(LookaheadJob& job, count_t nodeLimit) const;
+  /* merges a finished lookahead job into the master search space (features,
+   * stats and profiles, best solution found); returns true iff the
+   * subproblem was solved */
+  bool mergeLookahead(const LookaheadJob& job);
 
   /* compiles the name of a temporary file */
   string filename(const char* pre, const char* ext, int count = NONE) const;
@@ -101,11 +164,31 @@ protected:
   /* waits for all external jobs to finish */
   bool waitForGrid() const;
 
+  /* packs the external subproblems into worker jobs, largest predicted
+   * first; with --batch-nodes, consecutive smaller subproblems share a job
+   * up to the given predicted node count, otherwise every job has one */
+  void packJobs(vector<vector<size_t> >& jobs) const;
+  /* builds the worker command line for the given external subproblems */
+  void workerArguments(const vector<size_t>& ids, vector<string>& args) const;
+  /* parses the solution of external subproblem 'id' from (legacy gzip)
+   * stream 'in' and applies it */
+  bool readExtResult(size_t id, istream& in, vector<pair<count_t, count_t> >& nodecounts);
+  /* applies the result record of external subproblem 'id': records the
+   * node counts and propagates the solution, or re-splits the subproblem
+   * if its worker stopped early */
+  bool applyResult(size_t id, const SubproblemResult& r,
+                   vector<pair<count_t, count_t> >& nodecounts);
+
+  /* writes the subproblems (context and PST) to the given file */
+  bool writeSubproblemFile(const vector<SearchNode*>&, const string& file) const;
   /* creates the encoding of subproblems for the condor submission */
   string encodeJobs(const vector<SearchNode*>&) const;
   /* writes subproblem statistics to CSV file, solution node counts optional */
   void writeStatsCSV(const vector<SearchNode*>& subprobs,
                      const vector<pair<count_t, count_t> >* nodecounts = NULL) const;
+  /* compares the complexity estimates of the external subproblems to their
+   * actual AND node counts, if a learned model was used */
+  void reportPredictionError(const vector<pair<count_t, count_t> >& nodecounts) const;
   /* tries to read node counts from existing CSV file, saved into referenced
    * vector (as numeral strings). Returns true in case of success, false otherwise. */
   bool readCountsFromCSV(const string& filename,
@@ -113,8 +196,8 @@ protected:
 
   /* clear stack for local solving */
   void resetLocalStack(SearchNode* node = NULL);
-  /* solves a subproblem locally through AOBB */
-  void solveLocal(SearchNode*);
+  /* solves a subproblem locally through AOBB, deleting no node above upperLimit */
+  void solveLocal(SearchNode*, SearchNode* upperLimit = NULL);
 
   /* computes the average depth of nodes / leaves, minus the given offset */
   double computeAvgDepth(const vector<count_t>&, const vector<count_t>&, int offset);
@@ -136,11 +219,20 @@ public:
   bool writeSubprobStats() const;
   /* initiates parallel subproblem computation through Condor */
   bool runCondor() const;
+  /* solves external subproblems with a pool of local worker processes,
+   * largest first; solutions are received through pipes and parsed right
+   * away, improved global lower bounds are sent to the running workers.
+   * Subproblems exceeding the worker budget (--split-time/--split-nodes)
+   * are re-split and their open parts queued again */
+  bool runLocalPool();
   /* parses the results from external subproblems */
   bool readExtResults();
   /* recreates the frontier given a previously written subproblem file */
   bool restoreFrontier();
 
+  /* claims and runs lookahead jobs until none are left (thread body) */
+  void lookaheadWorker(vector<LookaheadJob>& jobs, count_t nodeLimit);
+
   /* implemented from Search */
   count_t getSubproblemCount() const { return m_subprobCount; }
 
@@ -151,6 +243,19 @@ public:
 };
 
 
+/* functor to run a lookahead thread, see ParallelManager::applyAOBB() */
+class LookaheadThread {
+protected:
+  ParallelManager* m_manager;
+  vector<LookaheadJob>* m_jobs;
+  count_t m_nodeLimit;
+public:
+  void operator () () { m_manager->lookaheadWorker(*m_jobs, m_nodeLimit); }
+  LookaheadThread(ParallelManager* m, vector<LookaheadJob>* jobs, count_t limit)
+    : m_manager(m), m_jobs(jobs), m_nodeLimit(limit) {}
+};
+
+
 /* Inline definitions */
 
 inline bool ParallelManager::isDone() const {
@@ -0,0 +1,142 @@
+/*
+ * Portfolio.h
+ *
+ *  Copyright (C) 2008-2012 Lars Otten
+ *  This file is part of DAOOPT.
+ *
+ *  DAOOPT is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  DAOOPT is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with DAOOPT.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Lars Otten <lotten@ics.uci.edu>
+ */
+
+
+#ifndef PORTFOLIO_H_
+#define PORTFOLIO_H_
+
+#include "_base.h"
+
+#if not (defined PARALLEL_DYNAMIC || defined PARALLEL_STATIC || defined NOTHREADS)
+
+#include "Problem.h"
+#include "Pseudotree.h"
+#include "Heuristic.h"
+#include "ProgramOptions.h"
+#include "SearchSpace.h"
+#include "Search.h"
+
+#include "boost/thread.hpp"
+
+namespace daoopt {
+
+/* configuration of a single portfolio search */
+struct PortfolioConfig {
+  bool rotate;       // breadth-rotating AOBB instead of plain AOBB
+  int subprobOrder;  // subproblem order, only the heuristic orders (SUBPROB_HEUR_*)
+                     // differ from the one fixed by the pseudo tree
+  string name;       // as given on the command line
+  PortfolioConfig() : rotate(false), subprobOrder(NONE) {}
+};
+
+/*
+ * Portfolio of differently configured AOBB searches (--portfolio), run
+ * concurrently in threads over the shared problem, pseudo tree and heuristic.
+ * Each search has its own search space, the best solution found by any of
+ * them is shared as incumbent and used for pruning by all others; the first
+ * search to finish has proved optimality and stops the rest.
+ */
+class Portfolio {
+
+protected:
+  Problem* m_problem;
+  Pseudotree* m_pseudotree;
+  Heuristic* m_heuristic;
+  ProgramOptions* m_options;
+
+  vector<PortfolioConfig> m_configs;
+  vector<ProgramOptions*> m_searchOptions;  // per search, with its subproblem order
+  vector<SearchSpace*> m_spaces;
+  vector<Search*> m_searches;
+
+  /* the shared incumbent, updates are reported to the problem instance */
+  double m_bound;
+#ifndef NO_ASSIGNMENT
+  vector<val_t> m_tuple;
+#endif
+  size_t m_boundVersion;  // counts incumbent updates, for cheap polling
+  int m_winner;           // search that finished first (NONE while running)
+  boost::mutex m_mtx;     // protects the shared state above
+
+public:
+  /* parses the portfolio specification, a comma-separated list of search
+   * configurations "bab" or "rotate", each optionally followed by
+   * ":<suborder>"; returns false on error */
+  static bool parse(const string& spec, vector<PortfolioConfig>& configs);
+
+  /* sets up the searches, starting from the problem's current solution */
+  bool init(const vector<PortfolioConfig>& configs);
+  /* runs all searches until the first one finishes */
+  void run();
+  /* runs search i, polling and reporting the incumbent (thread body) */
+  void work(size_t i);
+
+  int getWinner() const { return m_winner; }
+  /* hands the search (and its space) that finished first over to the caller,
+   * the portfolio must outlive them (their options are kept here) */
+  Search* releaseSearch();
+  SearchSpace* releaseSpace();
+
+protected:
+  /* reports a solution found by search i, returns true if it improved the
+   * incumbent */
+  bool report(size_t i, double d
+#ifndef NO_ASSIGNMENT
+              , const vector<val_t>& tuple
+#endif
+              );
+  /* applies the incumbent to search i if it is newer than 'version', returns
+   * false if another search has finished already */
+  bool poll(size_t i, size_t& version);
+
+public:
+  Portfolio(Problem* p, Pseudotree* pt, Heuristic* h, ProgramOptions* opt);
+  ~Portfolio();
+
+};
+
+
+/* functor to run a single portfolio search */
+class PortfolioThread {
+protected:
+  Portfolio* m_portfolio;
+  size_t m_index;
+public:
+  void operator () () { m_portfolio->work(m_index); }
+  PortfolioThread(Portfolio* p, size_t i) : m_portfolio(p), m_index(i) {}
+};
+
+
+/* Inline definitions */
+
+inline Portfolio::Portfolio(Problem* p, Pseudotree* pt, Heuristic* h, ProgramOptions* opt) :
+    m_problem(p), m_pseudotree(pt), m_heuristic(h), m_options(opt),
+    m_bound(ELEM_NAN), m_boundVersion(0), m_winner(NONE) {
+  assert(p && pt && h && opt);
+}
+
+}  // namespace daoopt
+
+#endif /* not parallel, threads */
+
+#endif /* PORTFOLIO_H_ */
@@ -113,6 +113,10 @@ public:
   /* stores ordering from 'elim' in file 'file' */
   void saveOrdering(const string& file, const vector<int>& elim) const;
 
+  /* hash of the problem structure (domain sizes and function scopes),
+   * identifies structurally identical problems across runs */
+  uint64_t getFingerprint() const;
+
   /* removes evidence and unary-domain variables */
   void removeEvidence();
 
@@ -145,10 +149,23 @@ public:
    *  - noNodes is the number of OR/AND nodes
    *  - nodeProf and leafProf are the full and leaf node profiles
    *  - if toScreen==true, will skip the console output (file only)
+   *  - splitOpen, if given, flags the open root values of a subproblem
+   *    that was stopped for re-splitting (empty if it was finished), its
+   *    size and flags are appended to the file to terminate the record
    */
   void outputAndSaveSolution(const string& file, const SearchStats* nodestats,
                              const vector<count_t>& nodeProf, const vector<count_t>& leafProf,
-                             bool toScreen = true) const;
+                             bool toScreen = true, const vector<bool>* splitOpen = NULL) const;
+  /* same as above, but writes to the given stream (if not NULL), so that
+   * the solutions of a batch of subproblems can follow one another */
+  void outputAndSaveSolution(ostream* out, const SearchStats* nodestats,
+                             const vector<count_t>& nodeProf, const vector<count_t>& leafProf,
+                             bool toScreen = true, const vector<bool>* splitOpen = NULL) const;
+  /* appends the solution of subproblem 'id' as a binary result record
+   * (see ResultLog.h) to the given log file or pipe */
+  bool appendResult(const string& log, int id, const SearchStats* nodestats,
+                    const vector<count_t>& nodeProf, const vector<count_t>& leafProf,
+                    const vector<bool>* splitOpen = NULL) const;
 
 #ifndef NO_ASSIGNMENT
   /* returns true iff the index variable from the full set has been eliminated
@@ -37,14 +37,18 @@ namespace daoopt {
 struct ProgramOptions {
 public:
   bool nosearch; // abort before starting the actual search
+  bool nopipeline; // run the preprocessing stages in sequence
   bool nocaching; // disable caching
+  bool nofwdcheck; // disable forward checking on zero function entries
   bool autoCutoff; // enable automatic cutoff
   bool autoIter; // enable adaptive ordering limit
   bool orSearch; // use OR search (builds pseudo tree as chain)
   bool par_solveLocal; // solve all parallel subproblems locally
   bool par_preOnly; // static parallel: preprocessing only (generate subproblems)
   bool par_postOnly; // static parallel: postprocessing only (read solution files)
+  bool par_threaded; // dynamic parallel: solve subproblems in threads of the master
   bool rotate; // enables breadth-rotating AOBB
+  bool slsLive; // run SLS in a background thread during search, exchanging solutions
   bool order_cvo;  // enables Kalev's CVO ordering code
   int match;  // enables Alex Ihler's MBE library (moment-matching flag)
   int mplp;  // enables MPLP in Alex Ihler's MBE library (# iters)
@@ -58,6 +62,8 @@ public:
   int order_iterations; // no. of randomized order finding iterations
   int order_timelimit; // no. of seconds to look for variable ordering
   int order_tolerance; // allowed range of deviation from suggested optimal minfill heuristic
+  int order_threads; // no. of threads for randomized order finding
+  int order_objective; // objective for order finding, integers defined in _base.h
   int cutoff_depth; // fixed cutoff depth for central search
   int cutoff_width; // fixed width for central cutoff
   int nodes_init; // number of nodes for local initialization (times 10^6)
@@ -66,6 +72,9 @@ public:
   int local_size; // lower bound for problem size to be solved locally (times 10^6)
   int maxSubprob; // only generate this many subproblems, then abort (for testing)
   int lds;  // run initial LDS with this limit (-1: enabled)
+  int ldsThreads; // no. of threads for iterative LDS (limits 0..lds)
+  int ldsTime; // time budget (sec) for iterative LDS
+  int compThreads; // no. of threads for solving independent components
   int seed; // the seed for the random number generator
   int rotateLimit; // how many nodes to expand per subproblem stack before rotating
   int subprobOrder; // subproblem ordering, integers defined in _base.h
@@ -75,23 +84,36 @@ public:
   int maxWidthAbort; // upper bound for induced width, abort if above this
   int slsIter; // number of SLS iterations for initial lower bound
   int slsTime; // time per SLS iteration (in seconds)
+  int slsThreads; // no. of threads for parallel SLS restarts
   int aobbLookahead;  // max. number of nodes for parallel static AOBB subproblem lookahead
+  int lookahead_threads; // static parallel: no. of threads for AOBB subproblem lookahead
+  int par_poolSize; // static parallel: no. of local worker processes (instead of Condor)
+  int split_time; // time budget (sec) for a subproblem, re-split by master once exceeded
+  int split_nodes; // node budget (times 10^5) for a subproblem, as above
+  int batch_nodes; // static parallel: predicted nodes (times 10^5) per batched worker job
 
   double initialBound; // initial lower bound
+  double learnRegularization; // regularization weight for complexity prediction model
 
   std::string executableName; // name of the executable
+  std::string workerExecutable; // worker executable for local process pool
   std::string problemName; // name of the problem
   std::string runTag; // string tag of this particular run
+  std::string portfolio; // search configurations to run concurrently, comma-separated
   std::string sampleSizes; // Sequence of sizes for subproblem samples (for prediction),
                            // comma-separated list of doubles.
   std::string in_problemFile; // problem file path
   std::string in_evidenceFile; // evidence file path
   std::string in_mmapFile; // marginal MAP variables file path
   std::string in_orderingFile; // ordering file path
+  std::string in_orderingCache; // directory for persistent ordering cache
   std::string in_minibucketFile; // minibucket file path
   std::string in_subproblemFile; // subproblem file path
   std::string in_boundFile; // file with initial lower bound (from SLS, e.g.)
+  std::string in_boundUpdates; // file or pipe to poll for lower bound updates from master
+  std::string in_learnModel; // file with trained complexity prediction model
   std::string out_solutionFile; // file path to write solution to
+  std::string out_resultLog; // log file or pipe to append subproblem result records to
   std::string out_reducedFile; // file to save reduced network to
   std::string out_pstFile; // file to output pseudo tree description to (for plotting)
 
@@ -102,19 +124,21 @@ public:
 ProgramOptions* parseCommandLine(int argc, char** argv);
 
 inline ProgramOptions::ProgramOptions() :
-		      nosearch(false), nocaching(false), autoCutoff(false), autoIter(false), orSearch(false),
-		      par_solveLocal(false), par_preOnly(false), par_postOnly(false), rotate(false),
+		      nosearch(false), nopipeline(false), nocaching(false), nofwdcheck(false), autoCutoff(false), autoIter(false), orSearch(false),
+		      par_solveLocal(false), par_preOnly(false), par_postOnly(false), par_threaded(false), rotate(false), slsLive(false),
 		      order_cvo(false), match(-1), mplp(-1), mplps(-1), jglp(-1), jglps(-1),
 		      ibound(0), cbound(0), cbound_worker(0),
-		      threads(0), order_iterations(0), order_timelimit(0), order_tolerance(0),
+		      threads(0), order_iterations(0), order_timelimit(0), order_tolerance(0), order_threads(1),
+		      order_objective(ORDER_OBJ_WIDTH),
 		      cutoff_depth(NONE), cutoff_width(NONE),
 		      nodes_init(NONE), memlimit(NONE),
 		      cutoff_size(NONE), local_size(NONE), maxSubprob(NONE),
-		      lds(NONE), seed(NONE), rotateLimit(0), subprobOrder(NONE),
+		      lds(NONE), ldsThreads(1), ldsTime(NONE), compThreads(1), seed(NONE), rotateLimit(0), subprobOrder(NONE),
 		      sampleDepth(NONE), sampleScheme(NONE), sampleRepeat(NONE),
-		      maxWidthAbort(NONE), slsIter(0), slsTime(5),
-		      aobbLookahead(0),
-		      initialBound(ELEM_NAN) {}
+		      maxWidthAbort(NONE), slsIter(0), slsTime(5), slsThreads(1),
+		      aobbLookahead(0), lookahead_threads(1), par_poolSize(NONE), split_time(NONE), split_nodes(NONE),
+		      batch_nodes(NONE),
+		      initialBound(ELEM_NAN), learnRegularization(1.0) {}
 
 }  // namespace daoopt
 
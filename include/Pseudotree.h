@@ -72,8 +72,9 @@ protected:
 public:
   /* computes an elimination order into 'elim' and returns its induced width
    * if 'limit' is given, will terminate early if new order is worse than limit
-   * and return INT_MAX */
-  int eliminate(Graph G, vector<int>& elim, int limit=INT_MAX, int tolerance=0);
+   * and return INT_MAX. Random tie breaking uses 'rs' if given, the global
+   * random number generator otherwise */
+  int eliminate(Graph G, vector<int>& elim, int limit=INT_MAX, int tolerance=0, RandStream* rs=NULL);
 
   /* builds the pseudo tree according to order 'elim' */
   void build(Graph G, const vector<int>& elim, const int cachelimit = NONE);
@@ -0,0 +1,105 @@
+/*
+ * ResultLog.h
+ *
+ *  Copyright (C) 2008-2012 Lars Otten
+ *  This file is part of DAOOPT.
+ *
+ *  DAOOPT is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  DAOOPT is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with DAOOPT.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Lars Otten <lotten@ics.uci.edu>
+ */
+
+#ifndef RESULTLOG_H_
+#define RESULTLOG_H_
+
+#include "_base.h"
+
+/* identifies result records ("DRES", little endian) and their format version */
+#define RESULT_MAGIC 0x53455244
+#define RESULT_VERSION 1
+
+namespace daoopt {
+
+/* solution of an external subproblem, as reported by a worker */
+struct SubproblemResult {
+  int32_t id;                   // subproblem id (NONE if not known to the worker)
+  double cost;                  // solution cost (NaN if none found)
+  count_t nodesOR;              // number of expanded OR nodes
+  count_t nodesAND;             // number of expanded AND nodes
+  vector<val_t> assignment;     // optimal subproblem assignment (may be empty)
+  vector<count_t> leafProfile;  // leaf nodes per depth
+  vector<count_t> nodeProfile;  // all nodes per depth (same size)
+  vector<bool> open;            // open root values, if stopped for re-splitting
+
+  SubproblemResult() : id(NONE), cost(ELEM_NAN), nodesOR(0), nodesAND(0) {}
+};
+
+
+/*
+ * Length-prefixed binary records for subproblem results, replacing the
+ * individual gzip solution files. Every record consists of a header
+ *   uint32 magic, uint16 version, uint16 (reserved), uint32 payload size
+ * followed by the payload (native byte order, like BINWRITE):
+ *   int32 id, double cost, uint64 OR nodes, uint64 AND nodes,
+ *   int32 n, n x int32 assignment,
+ *   int32 d, d x uint64 leaf profile, d x uint64 node profile,
+ *   int32 k, k x uint8 open root value flags.
+ * Each record is written in a single system call, so several workers can
+ * append to one log file (or pipe) concurrently. Readers can process the
+ * records incrementally as they arrive; records of a newer format version
+ * are skipped by their size.
+ */
+class ResultLog {
+public:
+  /* appends the complete record for 'r' to 'out' */
+  static void encode(const SubproblemResult& r, string& out);
+  /* decodes a version 1 payload, returns false if it is malformed */
+  static bool decode(const char* data, size_t size, SubproblemResult& r);
+  /* appends the record for 'r' to the given file or pipe, returns false on error */
+  static bool append(const string& path, const SubproblemResult& r);
+};
+
+
+/* incremental reader for a stream of result records */
+class ResultReader {
+protected:
+  string m_buffer;    // data received so far
+  size_t m_pos;       // start of the first unconsumed record in m_buffer
+  size_t m_skipped;   // number of records skipped (unknown version)
+  bool m_error;       // stream corrupted (bad header or payload)
+
+public:
+  /* adds data as it arrives */
+  void feed(const char* data, size_t size);
+  /* extracts the next complete record into 'r', returns false if there is
+   * none (yet) or the stream is corrupted */
+  bool next(SubproblemResult& r);
+
+  /* true iff part of a record remains unconsumed */
+  bool pending() const { return m_pos < m_buffer.size(); }
+  bool error() const { return m_error; }
+  size_t getSkipped() const { return m_skipped; }
+
+  /* reads all records from the given file into 'out', returns false if
+   * it can't be opened or is corrupted (complete records are kept) */
+  static bool readFile(const string& path, vector<SubproblemResult>& out);
+
+public:
+  ResultReader() : m_pos(0), m_skipped(0), m_error(false) {}
+};
+
+}  // namespace daoopt
+
+#endif /* RESULTLOG_H_ */
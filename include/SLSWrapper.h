@@ -36,6 +36,10 @@
 #include "sls4mpe/global.h"
 #include "sls4mpe/ProblemReader.h"
 
+#ifndef NOTHREADS
+#include "boost/thread.hpp"
+#endif
+
 namespace daoopt {
 
 class SLSWrapper {
@@ -43,12 +47,59 @@ protected:
   double m_likelihood;
   int* m_assignment;
   Problem* m_problem;
+  int m_numVars;            // no. of SLS variables (without dummy)
+  int m_iter;               // no. of SLS runs (restarts) in total
+  int m_time;               // time per run (in seconds)
+  int m_threads;            // no. of SLS instances, in parallel threads
+  long m_flips;             // local search flips over all instances
+  double m_flipTime;        // and the (thread) time spent on them
+
+  /* concurrent mode (--slsLive): SLS runs in a background thread during
+   * search, solutions are exchanged through the members below instead of
+   * going to the problem instance directly */
+  bool m_live;              // SLS runs concurrently with search
+  volatile bool m_stop;     // search is done, SLS should stop
+  double m_liveCost;        // latest improved SLS solution (NaN if none pending)
+  vector<val_t> m_liveSolution;
+  vector<int> m_restart;    // search solution to start the next SLS run from
+#ifndef NOTHREADS
+  scoped_ptr<boost::thread> m_thread;
+  boost::mutex m_mtx;       // protects the solutions above
+#endif
+
+protected:
+  /* loads the problem into the calling thread's SLS state (the sls4mpe
+   * globals are thread local) */
+  void load();
 
 public:
-  bool init(Problem* prob, int iter, int time);
+  bool init(Problem* prob, int iter, int time, int threads = 1);
+  /* runs the SLS restarts, split over the given number of threads */
   bool run();
+  /* runs instance i with its share of restarts and its own seed (thread body) */
+  void work(int i);
   double getSolution(vector<val_t>* tuple = NULL) const;
   void reportSolution(double cost, int num_vars, int* assignment);
+  /* returns the total no. of flips and sets 'rate' to the flips per second
+   * of a single instance */
+  long getFlipStats(double& rate) const;
+
+#ifndef NOTHREADS
+  /* runs SLS in a background thread, restarting until stopped */
+  void start();
+  /* signals the SLS thread to stop and waits for it */
+  void stop();
+  /* takes the latest SLS solution if it is better than 'bound',
+   * returns false otherwise */
+  bool poll(double bound, double& cost, vector<val_t>& tuple);
+  /* the next SLS run starts from this solution (of the search) */
+  void restartFrom(const vector<val_t>& tuple);
+#endif
+  /* called by SLS: true iff it should stop */
+  bool isStopped() const { return m_stop; }
+  /* called by SLS before each run: writes the restart solution to 'values'
+   * and returns true, if one was given since the last call */
+  bool getRestart(int* values, int num_vars);
 
 public:
   SLSWrapper();
@@ -56,13 +107,40 @@ public:
 };
 
 
+#ifndef NOTHREADS
+/* functor to run SLS in a background thread */
+class SLSThread {
+protected:
+  SLSWrapper* m_wrapper;
+public:
+  void operator () () { m_wrapper->run(); }
+  SLSThread(SLSWrapper* w) : m_wrapper(w) {}
+};
+
+/* functor to run a single SLS instance, see SLSWrapper::run() */
+class SLSRestartThread {
+protected:
+  SLSWrapper* m_wrapper;
+  int m_index;
+public:
+  void operator () () { m_wrapper->work(m_index); }
+  SLSRestartThread(SLSWrapper* w, int i) : m_wrapper(w), m_index(i) {}
+};
+#endif
+
+
 /* Inline definitions */
 inline SLSWrapper::SLSWrapper() :
-    m_likelihood(0.0), m_assignment(NULL) {
+    m_likelihood(0.0), m_assignment(NULL), m_problem(NULL),
+    m_numVars(0), m_iter(0), m_time(0), m_threads(1), m_flips(0), m_flipTime(0.0),
+    m_live(false), m_stop(false), m_liveCost(ELEM_NAN) {
   /* nothing here */
 };
 
 inline SLSWrapper::~SLSWrapper() {
+#ifndef NOTHREADS
+  stop();
+#endif
   if (m_assignment)
     delete[] m_assignment;
 }
@@ -35,6 +35,7 @@
 #ifdef PARALLEL_DYNAMIC
 #include "SubproblemHandler.h"
 #include "SubproblemCondor.h"
+#include "SubproblemThread.h"
 #endif
 
 namespace daoopt {
@@ -62,10 +63,20 @@ protected:
 
   vector<val_t> m_assignment;   // The current (partial assignment)
 
+  bool m_boundUpdated;          // PST root value was raised by updateGlobalBound()
+  double m_pstRootInit;         // PST root value before any such update
+
   vector<SearchNode*> m_expand;  // Reusable vector for node expansions (to avoid repeated
                                  // (de)allocation of memory)
   vector<double>      m_costTmp; // Reusable vector for cost calculations
 
+  /* Forward checking on zero entries of function tables: for each variable Y, the
+   * functions in its bucket that contain zeros, sorted by the depth of the deepest
+   * other scope variable; for each variable X, the list of <Y,k> pairs where the
+   * first k functions of Y are fully instantiated (except for Y) once X is assigned */
+  vector<vector<Function*> > m_fcFunctions;
+  vector<vector<pair<int,size_t> > > m_fcChecks;
+
 #ifdef PARALLEL_DYNAMIC
   /* keeps tracks up lower/upper bound on first OR node generated for
    * each depth level. used for initialization of cutoff scheme. */
@@ -89,6 +100,9 @@ public:
 
   const vector<count_t>& getNodeProfile() const { return m_nodeProfile; }
   const vector<count_t>& getLeafProfile() const { return m_leafProfile; }
+  /* adds the node and leaf profiles of a separately solved subproblem,
+   * whose root is at the given depth */
+  void addProfiles(const vector<count_t>& nodeP, const vector<count_t>& leafP, int depth);
   const vector<val_t>& getAssignment() const { return m_assignment; }
 
   /* returns the current lower bound on the root problem solution
@@ -114,6 +128,17 @@ public:
    * returns the (original) depth of the new root node */
   int restrictSubproblem(int rootVar, const vector<val_t>& assig, const vector<double>& pst);
 
+  /* raises the root value of the parent partial solution tree to the given
+   * global lower bound (e.g. received from the master), which canBePruned()
+   * then translates through the PST labels; only for conditioned subproblems.
+   * returns true iff the bound was an improvement */
+  bool updateGlobalBound(double d);
+
+  /* for an interrupted conditioned subproblem, flags the values of its root
+   * variable whose AND subproblems are not yet fully solved (or pruned);
+   * returns false if not a conditioned subproblem */
+  bool getOpenRootValues(vector<bool>& open) const;
+
   /* loads an initial lower bound from a file (in binary, for precision reasons).
    * returns true on success, false on error */
   bool loadInitialBound(string);
@@ -173,6 +198,13 @@ protected:
   /* checks if the node can be pruned (only meant for AND nodes) */
   bool canBePruned(SearchNode*) const;
 
+  /* precomputes the forward checking lists from the pseudo tree's function buckets */
+  void initForwardChecking();
+
+  /* checks the future variables affected by the assignment of var against the
+   * zero entries of their functions, returns true if a domain wipe-out is found */
+  bool forwardCheck(int var);
+
   /* computes the heuristic of a new OR node, which includes precomputing
    * its child AND nodes' heuristic and label values, which are cached
    * for their explicit generation */
@@ -183,6 +215,9 @@ protected:
    * solution tree, in case of conditioned subproblems) */
   double lowerBound(const SearchNode*) const;
 
+  /* true iff pruning of n was only possible due to updateGlobalBound() */
+  bool prunedByUpdate(SearchNode* n) const;
+
   /* the next two functions add context information to a search node. The difference
    * between the Cache and the Subprob version is that Cache might only be the partial
    * context (for adaptive caching) */
@@ -32,6 +32,7 @@ namespace daoopt {
 
 #include "SubproblemHandler.h"
 #include "SubproblemCondor.h"
+#include "SubproblemThread.h"
 #include "Statistics.h"
 
 
@@ -34,6 +34,7 @@
 #ifdef PARALLEL_DYNAMIC
 #include "Subproblem.h"
 #include "Statistics.h"
+#include "boost/lockfree/queue.hpp"
 #endif /* PARALLEL_DYNAMIC */
 
 #ifndef NO_CACHING
@@ -77,19 +78,21 @@ struct SearchStats {
 #endif
   size_t numLeaf;             // number of leaf nodes
   size_t numPruned;           // number of nodes pruned by the heuristic
+  size_t numPrunedBound;      // number of these only pruned due to bound updates
   size_t numDead;             // number of "dead end" nodes (probability 0)
   SearchStats() :
     numExpOR(0), numExpAND(0), numProcOR(0), numProcAND(0),
 #ifdef PARALLEL_STATIC
     numORext(0), numANDext(0),
 #endif
-    numLeaf(0), numPruned(0), numDead(0) {}
+    numLeaf(0), numPruned(0), numPrunedBound(0), numDead(0) {}
   SearchStats(const SearchStats& ns) :
     numExpOR(ns.numExpOR), numExpAND(ns.numExpAND), numProcOR(ns.numProcOR), numProcAND(ns.numProcAND),
 #ifdef PARALLEL_STATIC
     numORext(ns.numORext), numANDext(ns.numANDext),
 #endif
-    numLeaf(ns.numLeaf), numPruned(ns.numPruned), numDead(ns.numDead) {}
+    numLeaf(ns.numLeaf), numPruned(ns.numPruned), numPrunedBound(ns.numPrunedBound),
+    numDead(ns.numDead) {}
 };
 
 
@@ -139,9 +142,10 @@ struct SearchSpaceMaster : public SearchSpace {
 
   AvgStatistics* avgStats; // keeps track of subproblem statistics by averaging
 
-  /* queue for information exchange between components */
-  queue< Subproblem* > solved; // for externally solved subproblems
-  queue< SearchNode* > leaves; // for fully solved leaf nodes
+  /* lock-free queues for information exchange between components, producers
+   * call notifySolved() after pushing, the propagation thread drains them */
+  boost::lockfree::queue< Subproblem* > solved; // for externally solved subproblems
+  boost::lockfree::queue< SearchNode* > leaves; // for fully solved leaf nodes
   map< Subproblem*, boost::thread* > activeThreads;
 
   /* for pipelining the condor submissions */
@@ -166,7 +170,8 @@ struct SearchSpaceMaster : public SearchSpace {
   /* mutex for Statistics object */
   boost::mutex mtx_stats;
 
-  /* mutex and condition var. for the list of solved leaf nodes */
+  /* mutex and condition var. to wake up the propagation thread when the
+   * solved / leaves queues are empty (the queues themselves need no lock) */
   boost::mutex mtx_solved;
   boost::condition_variable_any cond_solved;
 
@@ -176,14 +181,30 @@ struct SearchSpaceMaster : public SearchSpace {
   /* mutex for condor */
   boost::mutex mtx_condor;
 
+  /* best global lower bound, broadcast to running subproblem solvers */
+  double globalBound;
+  string boundFile;  // file for Condor jobs to poll the bound from (if any)
+  boost::mutex mtx_bound;
+
+  /* wakes up the propagation thread after pushing to solved or leaves */
+  void notifySolved();
+
   SearchSpaceMaster(Pseudotree* pt, ProgramOptions* opt);
   ~SearchSpaceMaster();
 
 };
 
 
+inline void SearchSpaceMaster::notifySolved() {
+  // taking the lock avoids a lost wakeup between the consumer's emptiness
+  // check and its wait, it is only held for the notification itself
+  GETLOCK(mtx_solved, lk);
+  cond_solved.notify_one();
+}
+
 inline SearchSpaceMaster::SearchSpaceMaster(Pseudotree* pt, ProgramOptions* opt) :
-    SearchSpace(pt, opt), allowedThreads(MAX_THREADS), searchDone(false)
+    SearchSpace(pt, opt), solved(MAX_THREADS), leaves(MAX_THREADS),
+    allowedThreads(MAX_THREADS), searchDone(false), globalBound(ELEM_NAN)
 {
   if (options) allowedThreads = opt->threads;
 }
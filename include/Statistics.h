@@ -45,9 +45,16 @@ struct SubproblemStats {
   double upperBound;
   double lowerBound;
   double boundGap;
+  const SubprobStats* subprobStats;  // static stats of pseudo tree node
 
   void update(SearchNode*, PseudotreeNode*, count_t);
 
+  /* writes the feature vector used for complexity prediction */
+  void getFeatures(vector<double>& out) const;
+
+  SubproblemStats() : rootVar(NONE), numVars(0), depth(0), height(0), width(0),
+      subNodeCount(0), upperBound(ELEM_NAN), lowerBound(ELEM_NAN), boundGap(ELEM_NAN),
+      subprobStats(NULL) {}
 };
 
 ostream& operator << (ostream& os, const SubproblemStats& s);
@@ -67,10 +74,26 @@ inline void SubproblemStats::update(SearchNode* n, PseudotreeNode* pt, count_t c
   upperBound = n->getHeur();
   lowerBound = n->getInitialBound();
   boundGap = upperBound - lowerBound;
+  subprobStats = pt->getSubprobStats();
 
   subNodeCount = count;
 }
 
+inline void SubproblemStats::getFeatures(vector<double>& out) const {
+  out.clear();
+  out.push_back(depth);
+  out.push_back(numVars);
+  out.push_back(height);
+  out.push_back(width);
+  out.push_back(upperBound);
+  // no lower bound yet means unbounded gap, captured separately
+  bool noBound = (lowerBound == ELEM_ZERO || ISNAN(lowerBound));
+  out.push_back(noBound ? 1.0 : 0.0);
+  out.push_back(noBound ? 0.0 : boundGap);
+  if (subprobStats)
+    subprobStats->getAll(out);
+}
+
 }  // namespace daoopt
 
 #endif
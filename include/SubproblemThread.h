@@ -0,0 +1,75 @@
+/*
+ * SubproblemThread.h
+ *
+ *  Copyright (C) 2008-2012 Lars Otten
+ *  This file is part of DAOOPT.
+ *
+ *  DAOOPT is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  DAOOPT is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with DAOOPT.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Lars Otten <lotten@ics.uci.edu>
+ */
+
+#ifndef SUBPROBLEMTHREAD_H_
+#define SUBPROBLEMTHREAD_H_
+
+#include "SubproblemHandler.h"
+#include "Subproblem.h"
+#include "Heuristic.h"
+#include "Problem.h"
+#include "Pseudotree.h"
+
+#ifdef PARALLEL_DYNAMIC
+
+namespace daoopt {
+
+/* Solves a subproblem in a thread of the master process, through sequential
+ * AOBB on a copy of the pseudo tree restricted to the subproblem. Problem and
+ * heuristic are shared with the master (read-only). */
+class SubproblemThread : public SubproblemHandler {
+protected:
+  Subproblem*   m_subproblem;
+  size_t        m_threadId;
+  Problem*      m_problem;
+  Pseudotree*   m_pseudotree;
+  Heuristic*    m_heuristic;
+  vector<val_t> m_assignment;  // context assignment of the subproblem root
+  vector<double> m_pst;        // partial solution tree above root (top-down)
+public:
+  void operator() ();
+public:
+  /* note: needs to be constructed while the master search space is locked,
+   * copies the current assignment and the partial solution tree */
+  SubproblemThread(SearchSpaceMaster* p, Subproblem* n, size_t threadid,
+                   Problem* prob, Pseudotree* pt, Heuristic* h,
+                   const vector<val_t>& assig);
+};
+
+
+/* Inline definitions */
+
+inline SubproblemThread::SubproblemThread(SearchSpaceMaster* p, Subproblem* n, size_t id,
+                                          Problem* prob, Pseudotree* pt, Heuristic* h,
+                                          const vector<val_t>& assig)
+  : SubproblemHandler(p,n->root), m_subproblem(n), m_threadId(id),
+    m_problem(prob), m_pseudotree(pt), m_heuristic(h), m_assignment(assig) {
+  n->root->getPST(m_pst);  // bottom-up
+  reverse(m_pst.begin(), m_pst.end());  // top-down
+}
+
+}  // namespace daoopt
+
+#endif /* PARALLEL_DYNAMIC */
+
+#endif /* SUBPROBLEMTHREAD_H_ */
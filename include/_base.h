@@ -334,6 +334,13 @@ const int SUBPROB_HEUR_INC = 2;
 const int SUBPROB_HEUR_DEC = 3;
 const string subprob_order[4]
   = {"width-inc","width-dec","heur-inc","heur-dec"};
+
+const int ORDER_OBJ_WIDTH = 0;
+const int ORDER_OBJ_STATESPACE = 1;
+const int ORDER_OBJ_CACHE = 2;
+const int ORDER_OBJ_HEIGHT = 3;
+const string order_objective[4]
+  = {"width","state-space","cache-bytes","height"};
 }
 
 /*//////////////////////////////////////////////////////////////*/
@@ -354,6 +361,20 @@ public:
     return static_cast<int>( (state=_r()) / (_r.max()+1.0) * hi );
   }
 
+};
+
+/* Random number generator with its own state, for instance to give
+ * each of several threads an independent (and reproducible) stream */
+class RandStream {
+private:
+  boost::minstd_rand _r;
+public:
+  RandStream(const int& s) : _r(s) {}
+  int next() { return _r(); }
+  int next(const int& hi) {
+    return static_cast<int>( _r() / (_r.max()+1.0) * hi );
+  }
+
 };
 }  // namespace daoopt
 
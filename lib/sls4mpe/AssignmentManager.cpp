@@ -10,7 +10,7 @@
 
 namespace sls4mpe {
 
-daoopt::SLSWrapper* slsWrapper;  // for reporting solutions back
+SLS_TLS daoopt::SLSWrapper* slsWrapper;  // for reporting solutions back
 
 void AssignmentManager::outputCurrentAssignment(FILE* outfile){
 	copyAssignment(tmpAssignment);
@@ -186,6 +186,7 @@ double AssignmentManager::get_log_score(int* values){
 		}
 		result += localProbTables[pot]->logCPT[tmp_pot_ind];
 		localProbTables[pot]->index = tmp_pot_ind; // this is done to be able to use pot_index in the pertubation!
+		localProbTables[pot]->updateUtility();
 	}
 	return result;
 }
@@ -22,6 +22,7 @@ void ProbabilityTable::defaultInitialization(){
 	factorOfVar = NULL;
 	logCPT = NULL;
 	penalty = NULL;
+	utility = NULL;
 }
 
 ProbabilityTable::ProbabilityTable(){
@@ -158,6 +159,7 @@ void ProbabilityTable::setLogEntry(int index, double entry) {
 
 void ProbabilityTable::initRun(){
 	for(int i=0; i<numEntries; i++) penalty[i] = 0;
+	updateUtility();
 }
 
 int ProbabilityTable::sampleIndex(double greedyness){
@@ -43,6 +43,7 @@ public:
 	double currLogProb();
 	double currPenalty();
 	double currUtility();
+	void updateUtility();
 	void incCurrPenalty(double increment, int caching, int* good_vars, int* num_good_vars);
 	void scalePenalties(double scaleFactor);
 
@@ -71,6 +72,7 @@ public:
 	              // then the first parent ptVars[1], then the 2nd, etc.
 	double* penalty; // penalty[j] is the penalty for the j'th entry in the cpt.
 	double highestLogProb;
+	double* utility; // if set, the table's leaf in the potUtility max-tree (see initFlatStructures())
 
 private:
 	int* factorOfGlobalVar; // factorOfVar[var] = k <=> var has factor k in this table.
@@ -99,8 +101,21 @@ inline double ProbabilityTable::currUtility(){
 	return -logCPT[index] / (1.0+ penalty[index]);
 }
 
+inline void ProbabilityTable::updateUtility(){
+	if(!utility) return;
+	//=== Set the leaf and update the maxima above it, as far as they change.
+	int node = utility - potUtility;
+	potUtility[node] = currUtility();
+	for(node /= 2; node >= 1; node /= 2){
+		double maxChild = MAX(potUtility[2*node], potUtility[2*node+1]);
+		if(potUtility[node] == maxChild) break;
+		potUtility[node] = maxChild;
+	}
+}
+
 inline void ProbabilityTable::incCurrPenalty(double increment, int caching, int* good_vars, int* num_good_vars){
 	penalty[index] += increment;
+	updateUtility();
 	if(caching == CACHING_GOOD_VARS || caching == CACHING_SCORE || caching == CACHING_GOOD_PQ){
 		for(int i=0; i<numPTVars; i++){
 			int var = ptVars[i];
@@ -118,7 +133,7 @@ inline void ProbabilityTable::incCurrPenalty(double increment, int caching, int*
 					isgoodvar[var] = true;
 				}
 				if(caching == CACHING_GOOD_VARS){
-					insert(good_vars,num_good_vars,var);
+					addGoodVar(good_vars,num_good_vars,var);
 				}
 				if(caching == CACHING_GOOD_PQ){
 					if(!variables[var]->fixed){
@@ -132,6 +147,7 @@ inline void ProbabilityTable::incCurrPenalty(double increment, int caching, int*
 
 inline void ProbabilityTable::scalePenalties(double scaleFactor){
 	for(int i=0; i<numEntries; i++) penalty[i] *= scaleFactor;
+	updateUtility();
 }
 
 inline double ProbabilityTable::logProbWithVarFlipped(int globalVar, int value){
@@ -149,6 +165,7 @@ inline double ProbabilityTable::diffPenaltyWithVarFlipped(int localVar, int valu
 inline double ProbabilityTable::change(int localVar, int value){
 	int oldIndex = index;
 	index += (value-variables[ptVars[localVar]]->value) * factorOfVar[localVar];
+	updateUtility();
 	return logCPT[index] - logCPT[oldIndex];
 }
 
@@ -15,8 +15,8 @@
 
 namespace sls4mpe {
 
-char bntFileAndFunctionName[1000];
-int inputType = 0; // bn in .simple format
+SLS_TLS char bntFileAndFunctionName[1000];
+SLS_TLS int inputType = 0; // bn in .simple format
 
 void ProblemReader::readNetwork(){
 
@@ -57,7 +57,7 @@ bool Variable::flipTo(int newValue, int numFlip, int* good_vars, int* num_good_v
 //		assert(false);
 	}
 
-	int old_pot_index, j, val, num, var2;
+	int old_pot_index, j, val, var2;
 	//	fprintf(stderr, "flip %d to %d\n",inst.var,inst.value);
 
 	if (caching == CACHING_INDICES){
@@ -70,82 +70,66 @@ bool Variable::flipTo(int newValue, int numFlip, int* good_vars, int* num_good_v
 
 //=== For CACHING_SCORE and CACHING_GOOD_VARS and CACHING_GOOD_PQ, cache the score.
 	if (caching==CACHING_SCORE || caching==CACHING_GOOD_VARS || caching==CACHING_GOOD_PQ){
+		//=== The change of the flipped var's own scores summed over all its potentials.
+		double sum_diff_logProbScore = 0;
+		double sum_diff_penaltyScore = 0;
 
 		for(j=0; j<numOcc; j++){
 	//=== For each potential var occurs in, do lots of computation for the caching.
 			int pot = occ[j];
+			ProbabilityTable* pt = probTables[pot];
 			//=== Save old pot_index.
-			old_pot_index = probTables[pot]->index;
-
-			//double diff_score = probTables[pot]->diffLogProbWithVarFlipped(numInOcc[j], newValue) + probTables[pot]->diffPenaltyWithVarFlipped(numInOcc[j], newValue);
-			double diff_logProbScore = probTables[pot]->diffLogProbWithVarFlipped(numInOcc[j], newValue);
-			double diff_penaltyScore = probTables[pot]->diffPenaltyWithVarFlipped(numInOcc[j], newValue);
-
-			(*log_prob) += probTables[pot]->change(numInOcc[j], newValue);
-			int index = probTables[pot]->index;
-			
-	//=== Update the scores of all var-value pairs for vars in pot.
-			//=== Change scores for the flipped var. (Only reflecting the change from this prob_table)
-			for(val=0; val<domSize; val++){
-				logProbScores[val] -= diff_logProbScore;
-				penaltyScores[val] -= diff_penaltyScore;
-				//scores[val] -= diff_score;
-			}
-			//=== To counter bad problems with numerical inexactness,
-			//=== set the score of the new var and the new val to 0.
-			//=== It is 0 anyways, but the caching is subject to numerical instabilities.
-			//=== When it is slightly positive, just above EPS, we're caught in 
-			//=== an endless loop!
-			penaltyScores[newValue] = 0;
-			logProbScores[newValue] = 0;
-			//scores[newValue] = 0;
-			
-			for(num=0; num<probTables[pot]->numPTVars; num++){
-				if( num == numInOcc[j] ) continue; // var itself is a special case and handled above.
-				var2 = probTables[pot]->ptVars[num];
-				int var2_factor = probTables[pot]->factorOfVar[num];
+			old_pot_index = pt->index;
+
+			double diff_logProbScore = pt->diffLogProbWithVarFlipped(numInOcc[j], newValue);
+			double diff_penaltyScore = pt->diffPenaltyWithVarFlipped(numInOcc[j], newValue);
+			sum_diff_logProbScore += diff_logProbScore;
+			sum_diff_penaltyScore += diff_penaltyScore;
+
+			(*log_prob) += pt->change(numInOcc[j], newValue);
+			int index = pt->index;
+			const double* logCPT = pt->logCPT;
+			const double* penalty = pt->penalty;
+
+	//=== Update the scores of the other vars var2 in pot, using the flat adjacency.
+			const int adjStart = potAdjStart[pot];
+			const int adjEnd = potAdjStart[pot+1];
+			for(int adj=adjStart; adj<adjEnd; adj++){
+				if( adj - adjStart == numInOcc[j] ) continue; // var itself is a special case and handled below.
+				var2 = potAdjVar[adj];
+				const int var2_factor = potAdjFactor[adj];
+				Variable* v2 = variables[var2];
+				double* var2LogProbScores = v2->logProbScores;
+				double* var2PenaltyScores = v2->penaltyScores;
 
 				//== Compute change in index when var2 is set to val=0.
-				int var2indexIncrease = -var2_factor * variables[var2]->value;
-
-				//=== Compute changes in the scores of the other variables var2 in the potential when flipping var.
-				for(val=0; val<variables[var2]->domSize; val++){
-					//== Here: variables[var2]->scores[val] = k <=> before var was flipped, if I flip var2 to val it buys us k
-					// (actually, scores subsumes this cached value from all prob_tables)
-					
-					variables[var2]->penaltyScores[val] -= (-glsPenaltyMultFactor*probTables[pot]->penalty[old_pot_index + var2indexIncrease]);
-					variables[var2]->penaltyScores[val] += (-glsPenaltyMultFactor*probTables[pot]->penalty[index + var2indexIncrease]);
-
-					variables[var2]->logProbScores[val] -= probTables[pot]->logCPT[old_pot_index + var2indexIncrease];
-					variables[var2]->logProbScores[val] += probTables[pot]->logCPT[index + var2indexIncrease];
-
-/*
-					if(justPenalty){
-						variables[var2]->scores[val] -= (-glsPenaltyMultFactor*probTables[pot]->penalty[old_pot_index + var2indexIncrease]);
-						variables[var2]->scores[val] += (-glsPenaltyMultFactor*probTables[pot]->penalty[index + var2indexIncrease]);
-						if( glsReal ){
-							variables[var2]->scores[val] -= probTables[pot]->logCPT[old_pot_index + var2indexIncrease];
-							variables[var2]->scores[val] += probTables[pot]->logCPT[index + var2indexIncrease];
-						}
-					} else{
-						variables[var2]->scores[val] -= probTables[pot]->logCPT[old_pot_index + var2indexIncrease];
-						variables[var2]->scores[val] += probTables[pot]->logCPT[index + var2indexIncrease];
-					}
-*/
-					//variables[var2]->scores[val] -= diff_score;
-					variables[var2]->logProbScores[val] -= diff_logProbScore;
-					variables[var2]->penaltyScores[val] -= diff_penaltyScore;
-					
-					//== Here: variables[var2]->scores[val] = k <=> after var was flipped, if I flip var2 to val it buys us k
-					// (actually, the difference between above and here is just that var has been
-					// flipped in this prob_table. The outer loop is iterating the affected prob_tables)
-
+				int var2indexIncrease = -var2_factor * v2->value;
+
+				//=== Before the flip, var2's scores[val] = k <=> flipping var2 to val buys us k
+				//=== (summed over all prob_tables). Only this prob_table changes by flipping var,
+				//=== so we replace its contribution by the new one.
+				for(val=0; val<v2->domSize; val++){
+					var2LogProbScores[val] += logCPT[index + var2indexIncrease] - logCPT[old_pot_index + var2indexIncrease] - diff_logProbScore;
+					var2PenaltyScores[val] += glsPenaltyMultFactor*(penalty[old_pot_index + var2indexIncrease] - penalty[index + var2indexIncrease]) - diff_penaltyScore;
 					//=== Increment var2indexIncrease for the next val.
 					var2indexIncrease += var2_factor;
 				}
 			}
 		}
 
+		//=== Change scores for the flipped var, reflecting all its prob_tables at once.
+		for(val=0; val<domSize; val++){
+			logProbScores[val] -= sum_diff_logProbScore;
+			penaltyScores[val] -= sum_diff_penaltyScore;
+		}
+		//=== To counter bad problems with numerical inexactness,
+		//=== set the score of the new var and the new val to 0.
+		//=== It is 0 anyways, but the caching is subject to numerical instabilities.
+		//=== When it is slightly positive, just above EPS, we're caught in 
+		//=== an endless loop!
+		penaltyScores[newValue] = 0;
+		logProbScores[newValue] = 0;
+
 //=== For CACHING_GOOD_VARS and CACHING_GOOD_PQ, cache the good vars.
 		if(caching==CACHING_GOOD_VARS || caching==CACHING_GOOD_PQ){
 			//=== For all vars in Markov blanket of var, update whether they can lead to an improvement.
@@ -158,9 +142,11 @@ bool Variable::flipTo(int newValue, int numFlip, int* good_vars, int* num_good_v
 
 				bool is_good_var = false;
 				double bestValScore = -DOUBLE_BIG;
-				for(val=0; val<variables[var2]->domSize; val++){
-					if(variables[var2]->score(val) > bestValScore){
-						bestValScore = variables[var2]->score(val);
+				Variable* v2 = variables[var2];
+				for(val=0; val<v2->domSize; val++){
+					double valScore = v2->score(val);
+					if(valScore > bestValScore){
+						bestValScore = valScore;
 					}
 				}
 				if( bestValScore > EPS){
@@ -178,7 +164,7 @@ bool Variable::flipTo(int newValue, int numFlip, int* good_vars, int* num_good_v
 					}
 					if(caching==CACHING_GOOD_VARS){
 	//					assert(!contains(good_vars, (*num_good_vars), var2));
-						good_vars[(*num_good_vars)++] = var2;
+						addGoodVar(good_vars, num_good_vars, var2);
 						//insert(good_vars,num_good_vars,var2);
 	//					assert(contains(good_vars, (*num_good_vars), var2));
 	//					assert(!contains2(good_vars, (*num_good_vars), var2));
@@ -193,7 +179,7 @@ bool Variable::flipTo(int newValue, int numFlip, int* good_vars, int* num_good_v
 						isgoodvar[var2] = false;
 						if( caching==CACHING_GOOD_VARS ){
 	//						assert(contains(good_vars, (*num_good_vars), var2));
-							remove(good_vars,num_good_vars,var2);
+							removeGoodVar(good_vars,num_good_vars,var2);
 	//						assert(!contains(good_vars, (*num_good_vars), var2));
 		//					printf("is no good var: %d\n", var2);
 						} else { // caching PQ
@@ -240,6 +226,15 @@ void Variable::allocateOcc(){
 	occ = new int[numOcc];
 }
 
+//=== Uses block[0..domSize-1] for the logProbScores and the next domSize
+//=== doubles for the penaltyScores; the block is owned by the caller.
+void Variable::bindScores(double* block){
+	if (logProbScores) delete[] logProbScores;
+	if (penaltyScores) delete[] penaltyScores;
+	logProbScores = block;
+	penaltyScores = block + domSize;
+}
+
 void Variable::removeVarFromMB(int var){
 	if(contains(mb, numVarsInMB, var)){
 		remove(mb,&numVarsInMB, var);
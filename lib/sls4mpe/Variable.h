@@ -27,6 +27,7 @@ public:
 	void setName(char* newName);
 	void setDomainSize(int newDomainSize);
 	void allocateOcc();
+	void bindScores(double* block);
 	void setnumVarsInMB(int newnumVarsInMB);
 	double score(int value);
 
@@ -96,6 +97,20 @@ double inline Variable::score(int value){
   return logProbScores[value];
 }
 
+//=== O(1) updates of the good vars (CACHING_GOOD_VARS) using goodVarPos,
+//=== removal moves the last good var into the gap as before.
+void inline addGoodVar(int* good_vars, int* num_good_vars, int var){
+	goodVarPos[var] = *num_good_vars;
+	good_vars[(*num_good_vars)++] = var;
+}
+
+void inline removeGoodVar(int* good_vars, int* num_good_vars, int var){
+	int pos = goodVarPos[var];
+	int last = good_vars[--(*num_good_vars)];
+	good_vars[pos] = last;
+	goodVarPos[last] = pos;
+}
+
 }  // sls4mpe
 
 #endif
@@ -100,91 +100,100 @@ struct instantiation{
 };
 
 //Parameter:
-extern int maxRuns;
-extern double maxTime;
-extern int maxIterations;
-extern long maxSteps;
-
-extern int caching;
-extern int init_algo;
-extern int pertubationType;
-
-extern int noout;
-extern int output_res;
-extern bool onlyConvertToBNT;
-
-extern int output_to_stdout;
-extern int output_lm;
-extern bool justStats;
-extern int output_runstats;
-extern int output_trajectory;
-
-extern char sls_filename[1000];
-extern char res_filename[1000];
-extern char network_filename[1000];
-extern char traj_it_filename[1000];
-extern char traj_fl_filename[1000];
-extern FILE *outfile;
-extern FILE *resfile;
-extern FILE *traj_it_file;
-extern FILE *traj_fl_file;
+extern SLS_TLS int maxRuns;
+extern SLS_TLS long initialSeed;
+extern SLS_TLS double maxTime;
+extern SLS_TLS int maxIterations;
+extern SLS_TLS long maxSteps;
+
+extern SLS_TLS int caching;
+extern SLS_TLS int init_algo;
+extern SLS_TLS int pertubationType;
+
+extern SLS_TLS int noout;
+extern SLS_TLS int output_res;
+extern SLS_TLS bool onlyConvertToBNT;
+
+extern SLS_TLS int output_to_stdout;
+extern SLS_TLS int output_lm;
+extern SLS_TLS bool justStats;
+extern SLS_TLS int output_runstats;
+extern SLS_TLS int output_trajectory;
+
+extern SLS_TLS char sls_filename[1000];
+extern SLS_TLS char res_filename[1000];
+extern SLS_TLS char network_filename[1000];
+extern SLS_TLS char traj_it_filename[1000];
+extern SLS_TLS char traj_fl_filename[1000];
+extern SLS_TLS FILE *outfile;
+extern SLS_TLS FILE *resfile;
+extern SLS_TLS FILE *traj_it_file;
+extern SLS_TLS FILE *traj_fl_file;
 
 // old ILS params
-extern double tmult;
-extern double tdiv;
-extern double tmin;
-extern double tbase;
-extern double T;
-extern int pertubationType;
-extern int num_vns_pertubation_strength;
-extern int mbPertubation;
-extern bool vns;
-extern int restartNumFactor;
-extern bool pertubationFixVars;
-extern bool pertubation_rel;
-extern double psp_base;
-extern double psa_base;
-extern int tl;
-extern int accCriterion;
-extern double worseningInterval;
-extern double accNoise;
+extern SLS_TLS double tmult;
+extern SLS_TLS double tdiv;
+extern SLS_TLS double tmin;
+extern SLS_TLS double tbase;
+extern SLS_TLS double T;
+extern SLS_TLS int pertubationType;
+extern SLS_TLS int num_vns_pertubation_strength;
+extern SLS_TLS int mbPertubation;
+extern SLS_TLS bool vns;
+extern SLS_TLS int restartNumFactor;
+extern SLS_TLS bool pertubationFixVars;
+extern SLS_TLS bool pertubation_rel;
+extern SLS_TLS double psp_base;
+extern SLS_TLS double psa_base;
+extern SLS_TLS int tl;
+extern SLS_TLS int accCriterion;
+extern SLS_TLS double worseningInterval;
+extern SLS_TLS double accNoise;
 
 //old GLS params
-extern double glsPenaltyIncrement;
-extern int glsAspiration;
+extern SLS_TLS double glsPenaltyIncrement;
+extern SLS_TLS int glsAspiration;
 
 // actual ILS params;
-extern int pertubation_strength;
-extern double preprocessingSizeBound;
-extern double maxMBWeight;
-extern double glsSmooth;
-extern int glsInterval;
-extern int noise;
-extern double cutoff;
-
-extern double run_time_so_far;
-
-extern bool outputBestMPE;
-extern AssignmentManager* assignmentManager;
-extern double log_prob;
-extern int num_vars;
-extern int num_pots;
-extern bool* isgoodvar;
-extern struct fheap *heapOfGoodVars;
-extern int glsReal;
-extern int algo;
-extern double glsPenaltyMultFactor;
-
-extern ProbabilityTable** probTables;
-extern Variable** variables;
+extern SLS_TLS int pertubation_strength;
+extern SLS_TLS double preprocessingSizeBound;
+extern SLS_TLS double maxMBWeight;
+extern SLS_TLS double glsSmooth;
+extern SLS_TLS int glsInterval;
+extern SLS_TLS int noise;
+extern SLS_TLS double cutoff;
+
+extern SLS_TLS double run_time_so_far;
+extern SLS_TLS long totalFlips;
+extern SLS_TLS double totalFlipTime;
+
+extern SLS_TLS bool outputBestMPE;
+extern SLS_TLS AssignmentManager* assignmentManager;
+extern SLS_TLS double log_prob;
+extern SLS_TLS int num_vars;
+extern SLS_TLS int num_pots;
+extern SLS_TLS bool* isgoodvar;
+extern SLS_TLS int* goodVarPos;
+extern SLS_TLS double* scoreBlock;
+extern SLS_TLS int* potAdjStart;
+extern SLS_TLS int* potAdjVar;
+extern SLS_TLS int* potAdjFactor;
+extern SLS_TLS double* potUtility;
+extern SLS_TLS struct fheap *heapOfGoodVars;
+extern SLS_TLS int glsReal;
+extern SLS_TLS int algo;
+extern SLS_TLS double glsPenaltyMultFactor;
+
+extern SLS_TLS ProbabilityTable** probTables;
+extern SLS_TLS Variable** variables;
 //extern AssignmentManager* assignmentManager;
 
 const int NUM_BP_VARS = 100000;
-extern int externalInitValues[NUM_BP_VARS];
+extern SLS_TLS int externalInitValues[NUM_BP_VARS];
 
-extern bool verbose;
+extern SLS_TLS bool verbose;
 
-extern daoopt::SLSWrapper* slsWrapper;
+extern SLS_TLS daoopt::SLSWrapper* slsWrapper;
 
 }  // sls4mpe
 
@@ -22,92 +22,106 @@ namespace sls4mpe {
 
 #define FORBIDDEN(var,val) (variables[(var)]->fixed || num_flip <= variables[(var)]->tabuValues[(val)]+tl || variables[(var)]->value == (val))
 
-int num_vars;
-int num_pots;
-int numVarValCombos;
-
-AssignmentManager* assignmentManager;
-ProblemReader* pR;
-MiniBucketElimination* mbeElim;
-ProbabilityTable** probTables;
-Variable** variables;
-int* mbAssignment;
-int* fakeEvidenceForMB;
-int numFakeEvidenceForMB;
-bool* isgoodvar;
-int* initValues;
-int externalInitValues[NUM_BP_VARS];
-int MAXVARS_IN_FACTOR = 30;
+SLS_TLS int num_vars;
+SLS_TLS int num_pots;
+SLS_TLS int numVarValCombos;
+
+SLS_TLS AssignmentManager* assignmentManager;
+SLS_TLS ProblemReader* pR;
+SLS_TLS MiniBucketElimination* mbeElim;
+SLS_TLS ProbabilityTable** probTables;
+SLS_TLS Variable** variables;
+SLS_TLS int* mbAssignment;
+SLS_TLS int* fakeEvidenceForMB;
+SLS_TLS int numFakeEvidenceForMB;
+SLS_TLS bool* isgoodvar;
+SLS_TLS int* goodVarPos; // goodVarPos[var] = j <=> good_vars[j] = var (if isgoodvar[var])
+
+//=== Flat layout for the cached scores, see initFlatStructures().
+SLS_TLS double* scoreBlock = NULL; // logProbScores and penaltyScores of all vars, one after the other
+SLS_TLS int* potAdjStart;  // the vars of pot are potAdjVar[potAdjStart[pot]..potAdjStart[pot+1]-1],
+SLS_TLS int* potAdjVar;    // in the order of its ptVars, with their factors in potAdjFactor
+SLS_TLS int* potAdjFactor;
+SLS_TLS double* potUtility; // max-tree over the GLS utilities of all pots: node 1 is the root,
+                           // node k has children 2k and 2k+1, leaves start at potUtilityLeaves
+SLS_TLS int potUtilityLeaves;
+SLS_TLS int* maxUtilityPots; // pots found by collectMaxUtilityPots()
+SLS_TLS int* initValues;
+SLS_TLS int externalInitValues[NUM_BP_VARS];
+SLS_TLS int MAXVARS_IN_FACTOR = 30;
 
 /*********************************************/
 /* Main changing data structures			 */
 /*********************************************/
 
-int num_run;
-long num_flip;
-long num_iteration;
-int abort_flag;
-double log_prob;
-double last_log_prob;
-long last_steps;
-int *last_ils_value;
-int num_flipped_since_last_ils_solution;
-int *flipped_since_last_ils_solution;
-int *value_of_flipped_in_last_ils_solution;
-int *vns_pertubation_strength;
-int num_vns_pertubation_strength = 5;
-bool onlyConvertToBNT = false;
+SLS_TLS int num_run;
+SLS_TLS long num_flip;
+SLS_TLS long totalFlips;      // flips and local search time over all runs,
+SLS_TLS double totalFlipTime; // for the flip rate (see daoopt::SLSWrapper)
+SLS_TLS long num_iteration;
+SLS_TLS int abort_flag;
+SLS_TLS double log_prob;
+SLS_TLS double last_log_prob;
+SLS_TLS long last_steps;
+SLS_TLS int *last_ils_value;
+SLS_TLS int num_flipped_since_last_ils_solution;
+SLS_TLS int *flipped_since_last_ils_solution;
+SLS_TLS int *value_of_flipped_in_last_ils_solution;
+SLS_TLS int *vns_pertubation_strength;
+SLS_TLS int num_vns_pertubation_strength = 5;
+SLS_TLS bool onlyConvertToBNT = false;
 
 //=== Variables we only need in one function, but which need allocation.
 
-int *best_vars;
-int *best_vals;
+SLS_TLS int *best_vars;
+SLS_TLS int *best_vals;
 
-double *single_goods;
-double *sample_probs;
+SLS_TLS double *single_goods;
+SLS_TLS double *sample_probs;
 
 
 /*****************************************************/
 /* Global flags and parameters with default values   */
 /*****************************************************/
-bool outputBestMPE = true;
-int maxRuns = 10;
-
-int maxIterations = BIG;
-double maxTime = BIG;
-long int maxSteps = BIG;
-
-int caching = CACHING_GOOD_VARS;
-int algo = ALGO_GLS; // ALGO_ILS
-
-int tl = 0;
-bool tl_rel = false;//true;
-
-int mbPertubation = 0;
-double mbInitWeight = 1e5;
-double mbInitWeightForHybrid = 1e4;
-double maxMBWeight = 1e7;
-double psp_base = 1;
-double psa_base = 1; // 1;
-
-double preprocessingSizeBound = 1000;
-double preprocessingTime;
-
-int glsReal = 1;
-double glsPenaltyMultFactor = 10000;
-double glsPenaltyIncrement = 1.0;
-double glsSmooth = 0.999;
-int glsInterval = 200;
-int glsAspiration = 0;
-
-double tmult = 1.01;
-double tdiv = 2;
-double tmin = 0.001;
-double e = 2.7182818285;
-double tbase = e;
-double T = 0.01;
-
-bool verbose = false;
+SLS_TLS bool outputBestMPE = true;
+SLS_TLS int maxRuns = 10;
+SLS_TLS long initialSeed = 1; // differs between parallel instances
+
+SLS_TLS int maxIterations = BIG;
+SLS_TLS double maxTime = BIG;
+SLS_TLS long int maxSteps = BIG;
+
+SLS_TLS int caching = CACHING_GOOD_VARS;
+SLS_TLS int algo = ALGO_GLS; // ALGO_ILS
+
+SLS_TLS int tl = 0;
+SLS_TLS bool tl_rel = false;//true;
+
+SLS_TLS int mbPertubation = 0;
+SLS_TLS double mbInitWeight = 1e5;
+SLS_TLS double mbInitWeightForHybrid = 1e4;
+SLS_TLS double maxMBWeight = 1e7;
+SLS_TLS double psp_base = 1;
+SLS_TLS double psa_base = 1; // 1;
+
+SLS_TLS double preprocessingSizeBound = 1000;
+SLS_TLS double preprocessingTime;
+
+SLS_TLS int glsReal = 1;
+SLS_TLS double glsPenaltyMultFactor = 10000;
+SLS_TLS double glsPenaltyIncrement = 1.0;
+SLS_TLS double glsSmooth = 0.999;
+SLS_TLS int glsInterval = 200;
+SLS_TLS int glsAspiration = 0;
+
+SLS_TLS double tmult = 1.01;
+SLS_TLS double tdiv = 2;
+SLS_TLS double tmin = 0.001;
+const double e = 2.7182818285;
+SLS_TLS double tbase = e;
+SLS_TLS double T = 0.01;
+
+SLS_TLS bool verbose = false;
 
 /*
 int init_algo = INIT_RANDOM;
@@ -128,77 +142,77 @@ double accNoise = 0.01;
 
 
 ///*
-int init_algo = INIT_MB;
+SLS_TLS int init_algo = INIT_MB;
 
 //=== Parameters of the pertubation.
-int pertubationType = PERTUBATION_RANDOM_POTS_RANDOM_INDEX; // 0:random vars with random outcome
-bool vns = false;
-bool pertubationFixVars = true;
-int pertubation_strength = 2;
-bool pertubation_rel = false;
+SLS_TLS int pertubationType = PERTUBATION_RANDOM_POTS_RANDOM_INDEX; // 0:random vars with random outcome
+SLS_TLS bool vns = false;
+SLS_TLS bool pertubationFixVars = true;
+SLS_TLS int pertubation_strength = 2;
+SLS_TLS bool pertubation_rel = false;
 
 //=== Parameters of the acceptance criterion.
-int accCriterion = ACC_BETTER_RW;//ACC_RW_AFTER_N2;
-int restartNumFactor = 5;
-double worseningInterval = 5; // was absolute 100 and performed very well.
-double accNoise = 0.01;
+SLS_TLS int accCriterion = ACC_BETTER_RW;//ACC_RW_AFTER_N2;
+SLS_TLS int restartNumFactor = 5;
+SLS_TLS double worseningInterval = 5; // was absolute 100 and performed very well.
+SLS_TLS double accNoise = 0.01;
 //*/
 
 
-int noise = 40;
-double cutoff = 10;
+SLS_TLS int noise = 40;
+SLS_TLS double cutoff = 10;
 
-int start_iteration_of_current_try;
-int save_pertubation_strength = NOVALUE;
-int output_to_stdout = 0;
-int output_lm = 0;
-int output_trajectory = 0;
-int output_runstats = 0;
-int output_res = 0;
-int noout = 0;
-bool justStats;
+SLS_TLS int start_iteration_of_current_try;
+SLS_TLS int save_pertubation_strength = NOVALUE;
+SLS_TLS int output_to_stdout = 0;
+SLS_TLS int output_lm = 0;
+SLS_TLS int output_trajectory = 0;
+SLS_TLS int output_runstats = 0;
+SLS_TLS int output_res = 0;
+SLS_TLS int noout = 0;
+SLS_TLS bool justStats;
 
 /********************************************************
          Program internal parameters.
  ********************************************************/
-int seedThisRun;
-int num_good_vars;
-int *good_vars; // good_vars[j] = var <=> Flipping var can increase log_prob.
-struct fheap *heapOfGoodVars;
+SLS_TLS int seedThisRun;
+SLS_TLS int num_good_vars;
+SLS_TLS int *good_vars; // good_vars[j] = var <=> Flipping var can increase log_prob.
+SLS_TLS struct fheap *heapOfGoodVars;
 
-int *vars_permuted;
-int num_vars_permuted;
+SLS_TLS int *vars_permuted;
+SLS_TLS int num_vars_permuted;
 
-int num_pots_flipped;
-int *pots_flipped;    // pots_flipped[j] = pot <=> pot has been flipped in current pertubation.
+SLS_TLS int num_pots_flipped;
+SLS_TLS int *pots_flipped;    // pots_flipped[j] = pot <=> pot has been flipped in current pertubation.
 
-long lastImprovingIteration;
-double best_logprob_this_try;
+SLS_TLS long lastImprovingIteration;
+SLS_TLS double best_logprob_this_try;
 /************************************/
 /* Statistics                       */
 /************************************/
-int inducedWidth; // along the min-degree ordering
-double inducedWeight; // along the min-degree ordering
-double run_time_so_far;
-double bestQualNotAccepted;
-int *bestNotAccepted;
+SLS_TLS int inducedWidth; // along the min-degree ordering
+SLS_TLS double inducedWeight; // along the min-degree ordering
+SLS_TLS double run_time_so_far;
+SLS_TLS double bestQualNotAccepted;
+SLS_TLS int *bestNotAccepted;
 
-double overall_time_so_far;
-time_t timestamp_start;
+SLS_TLS double overall_time_so_far;
+SLS_TLS time_t timestamp_start;
 
-double init_time;
-double runInitTime;
+SLS_TLS double init_time;
+SLS_TLS double runInitTime;
 
-FILE *outfile = stdout;
-FILE *resfile;
-FILE *traj_it_file;
-FILE *traj_fl_file;
+SLS_TLS FILE *outfile = NULL; // stdout unless set, see first_init()
+SLS_TLS FILE *resfile;
+SLS_TLS FILE *traj_it_file;
+SLS_TLS FILE *traj_fl_file;
 
-char network_filename[1000];
-char sls_filename[1000];
-char res_filename[1000];
-char traj_it_filename[1000];
-char traj_fl_filename[1000];
+SLS_TLS char network_filename[1000];
+SLS_TLS char sls_filename[1000];
+SLS_TLS char res_filename[1000];
+SLS_TLS char traj_it_filename[1000];
+SLS_TLS char traj_fl_filename[1000];
 
 /********************************************************
  ========================================================
@@ -211,7 +225,8 @@ char traj_fl_filename[1000];
  Initializes the problem once to begin with.
  ********************************************************/
 void first_init(){
-	seed = 1; // DON'T SET IT TO 0 !!! Thomas' random number generator will only return zeros then !!!
+	if(!outfile) outfile = stdout;
+	seed = initialSeed; // DON'T SET IT TO 0 !!! Thomas' random number generator will only return zeros then !!!
 
 	//=== Init globals.
 	preprocessingTime = 0;
@@ -219,6 +234,8 @@ void first_init(){
 	time(&timestamp_start);
 	assignmentManager->init();
 	num_run = 0;
+	totalFlips = 0;
+	totalFlipTime = 0;
 }
 
 void read_problem(int argc,char *argv[]){
@@ -289,7 +306,7 @@ void runAlgorithm(int **outBestAssignment, double *outLogLikelihood){
 		anytime_mb();
 		end_run();
 	} else {
-		while (! abort_flag && num_run < maxRuns) {
+		while (! abort_flag && num_run < maxRuns && ! slsWrapper->isStopped()) {
 			init_run();
 			switch(algo) {
 				case ALGO_GN:
@@ -342,6 +359,8 @@ void end_run(){
 
 	run_time_so_far += elapsed_seconds();
 	overall_time_so_far += run_time_so_far;
+	totalFlips += num_flip;
+	totalFlipTime += run_time_so_far - preprocessingTime - runInitTime;
 }
 
 void update_if_new_best_in_run(){
@@ -497,7 +516,8 @@ void mb_ils_hybrid(){
 bool lsContinue(){
 	return run_time_so_far < maxTime 
 		  && num_flip < maxSteps 
-			&& assignmentManager->runBestLogProb+EPS < assignmentManager->optimalLogMPEValue;
+			&& assignmentManager->runBestLogProb+EPS < assignmentManager->optimalLogMPEValue
+			&& ! slsWrapper->isStopped();
 }
 
 bool ilsContinue(){
@@ -599,25 +619,31 @@ void greedy_noise(){
 	}
 }
 
-void increasePenalties(){
-	double maxUtility = -1;
-	double utility;
-	int pot;
-
-	//=== Determine maximal utility.
-	for(pot=0; pot<num_pots; pot++){
-		utility = probTables[pot]->currUtility();
-		if(utility > maxUtility){
-			maxUtility = utility;
+//=== Collects the pots with utility within EPS of maxUtility below node, in
+//=== increasing order, skipping subtrees whose maximum is too small.
+void collectMaxUtilityPots(int node, double maxUtility, int* numMaxPots){
+	if(potUtility[node] <= maxUtility - EPS) return;
+	if(node >= potUtilityLeaves){
+		if(fabs(potUtility[node] - maxUtility) < EPS){
+			maxUtilityPots[(*numMaxPots)++] = node - potUtilityLeaves;
 		}
+		return;
 	}
+	collectMaxUtilityPots(2*node, maxUtility, numMaxPots);
+	collectMaxUtilityPots(2*node+1, maxUtility, numMaxPots);
+}
+
+void increasePenalties(){
+	//=== Determine maximal utility (the tables keep the max-tree up to date).
+	double maxUtility = MAX(-1.0, potUtility[1]);
+	int i, numMaxPots = 0;
+	collectMaxUtilityPots(1, maxUtility, &numMaxPots);
 
 	//=== Increment penalty of entries with maximal utility.
-	for(pot=0; pot<num_pots; pot++){
-		if(fabs(probTables[pot]->currUtility() - maxUtility) < EPS){
-//				printf("incrementing penalty of table %d, index %d\n", pot, probTables[pot]->index);
-			probTables[pot]->incCurrPenalty(glsPenaltyIncrement, caching, good_vars, &num_good_vars );
-		}
+	for(i=0; i<numMaxPots; i++){
+		int pot = maxUtilityPots[i];
+//		printf("incrementing penalty of table %d, index %d\n", pot, probTables[pot]->index);
+		probTables[pot]->incCurrPenalty(glsPenaltyIncrement, caching, good_vars, &num_good_vars );
 	}
 }
 
@@ -668,10 +694,13 @@ void init_potIndices(){
 		for(int i=0; i<probTables[pot]->numPTVars; i++){
 			probTables[pot]->index += probTables[pot]->factorOfVar[i]*variables[probTables[pot]->ptVars[i]]->value;
 		}
+		probTables[pot]->updateUtility();
 	}
 }
 
 void computeInitValues(){
+	//=== Start from the search's solution, if concurrent (see SLSWrapper).
+	if(slsWrapper->getRestart(initValues, num_vars)) return;
 	switch(init_algo){
 		case INIT_RANDOM:
 			random_init();
@@ -1733,6 +1762,7 @@ void allocateMemoryForDataStructures(bool deleteFirst){
 
 	isgoodvar              = new bool[num_vars];
 	good_vars              = new int[num_vars];
+	goodVarPos             = new int[num_vars];
 	vars_permuted          = new int[num_vars];
 	fakeEvidenceForMB      = new int[num_vars];
 	mbAssignment           = new int[num_vars];
@@ -1759,6 +1789,23 @@ void allocateMemoryForDataStructures(bool deleteFirst){
 void tearDown(){
   delete[] isgoodvar;
 	delete[] good_vars;
+	delete[] goodVarPos;
+
+	if(scoreBlock){
+		//=== Variables don't own their scores anymore.
+		for(int var=0; var<num_vars; var++){
+			variables[var]->logProbScores = NULL;
+			variables[var]->penaltyScores = NULL;
+		}
+		delete[] scoreBlock;
+		scoreBlock = NULL;
+		delete[] potAdjStart;
+		delete[] potAdjVar;
+		delete[] potAdjFactor;
+		for(int pot=0; pot<num_pots; pot++) probTables[pot]->utility = NULL;
+		delete[] potUtility;
+		delete[] maxUtilityPots;
+	}
 	delete[] vars_permuted;
 	delete[] fakeEvidenceForMB;
 	delete[] mbAssignment;
@@ -1823,11 +1870,54 @@ void initFromVarsAndProbTables(){
 ********************************************************/
 	best_vars = new int[numVarValCombos];
 	best_vals = new int[numVarValCombos];
+	initFlatStructures();
 
 	setInputDependentParameters();
 	init_time = elapsed_seconds();
 }
 
+/********************************************************
+  Moves the cached scores of all variables into one
+  contiguous block and collects the variables of all
+  potentials in flat arrays, such that a flip only
+  touches a few cache lines (see Variable::flipTo).
+  Also keeps the GLS utilities of all potentials in
+  a max-tree, such that increasePenalties doesn't
+  need to scan all potentials in every local minimum.
+  Has to be done once the network is final.
+********************************************************/
+void initFlatStructures(){
+	int var, pot, num, offset = 0;
+	scoreBlock = new double[2*numVarValCombos];
+	for(var=0; var<num_vars; var++){
+		variables[var]->bindScores(scoreBlock + offset);
+		offset += 2*variables[var]->domSize;
+	}
+
+	potAdjStart = new int[num_pots+1];
+	potAdjStart[0] = 0;
+	for(pot=0; pot<num_pots; pot++){
+		potAdjStart[pot+1] = potAdjStart[pot] + probTables[pot]->numPTVars;
+	}
+	potAdjVar = new int[potAdjStart[num_pots]];
+	potAdjFactor = new int[potAdjStart[num_pots]];
+	for(pot=0; pot<num_pots; pot++){
+		for(num=0; num<probTables[pot]->numPTVars; num++){
+			potAdjVar[potAdjStart[pot]+num] = probTables[pot]->ptVars[num];
+			potAdjFactor[potAdjStart[pot]+num] = probTables[pot]->factorOfVar[num];
+		}
+	}
+
+	for(potUtilityLeaves=1; potUtilityLeaves<num_pots; potUtilityLeaves*=2);
+	potUtility = new double[2*potUtilityLeaves];
+	for(int node=0; node<2*potUtilityLeaves; node++) potUtility[node] = -DOUBLE_BIG;
+	//=== Leaves are set in init_potIndices(), once the indices are known.
+	for(pot=0; pot<num_pots; pot++){
+		probTables[pot]->utility = potUtility + potUtilityLeaves + pot;
+	}
+	maxUtilityPots = new int[num_pots];
+}
+
 void printStats(){
 	if(verbose) {
 		fprintf(outfile, "========================================\n        BASIC INSTANCE STATS\n========================================\n");
@@ -1870,7 +1960,7 @@ void setPotentialIndicesScoresAndGoodvars(bool keepPenalties){
 			}
 		}
 		if(good) {
-			good_vars[num_good_vars++] = var; // fast insert (know it's not in yet)
+			addGoodVar(good_vars, &num_good_vars, var); // fast insert (know it's not in yet)
 			if(!(caching==CACHING_GOOD_PQ && variables[var]->fixed)){
 				isgoodvar[var] = true;
 				fh_insert(heapOfGoodVars, var+1, -bestScoreVal);
@@ -9,7 +9,7 @@
 
 namespace sls4mpe {
 
-long int seed;
+SLS_TLS long int seed;
 
 double ran01( long *idum )
 /*    
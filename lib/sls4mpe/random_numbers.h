@@ -17,7 +17,7 @@
 
 namespace sls4mpe {
 
-extern long seed;
+extern SLS_TLS long seed;
 
 double ran01 ( long *idum );
 
@@ -15,16 +15,28 @@ namespace sls4mpe {
  ********************************************************/
 
 //=== When timer was initialized or elapsed seconds was called the last time.
-double lastTime;
+SLS_TLS double lastTime;
 
 #ifndef NT
 	//! Data structure for retrieving net computation time information via library calls from the operating system. 
 	static struct rusage res;
 #endif
 
+//=== CPU time of the calling thread (process CPU time if not available),
+//=== so SLS instances in parallel threads each get their full time budget.
+static double thread_clock(){
+	#if defined(CLOCK_THREAD_CPUTIME_ID) && !defined(NOTHREADS)
+		struct timespec ts;
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+		return (double) ts.tv_sec + (double) ts.tv_nsec / 1000000000.0;
+	#else
+		return (double) clock() / CLOCKS_PER_SEC;
+	#endif
+}
+
 void start_timer(){
 	#ifdef NT
-		lastTime = clock();
+		lastTime = thread_clock();
 	#else
     getrusage( RUSAGE_SELF, &res );
     lastTime = (double) res.ru_utime.tv_sec +
@@ -37,8 +49,8 @@ void start_timer(){
 double elapsed_seconds(){
 	double result = -1, thisTime = -1;
 	#ifdef NT
-		thisTime = clock();
-		result = (thisTime - lastTime) / CLOCKS_PER_SEC;;
+		thisTime = thread_clock();
+		result = thisTime - lastTime;
 	#else
     getrusage( RUSAGE_SELF, &res );
     thisTime =
@@ -8,8 +8,9 @@
 #include "DEFINES.h"
 #ifdef ENABLE_SLS
 
-#define WIN32 1
-#ifdef WIN32
+// always use the portable timer (this used to define WIN32, which
+// also switches other headers, like boost's, to Windows code)
+#ifndef NT
 	#define NT 1 
 #endif
 
@@ -0,0 +1,120 @@
+/*
+ * BoundChannel.cpp
+ *
+ *  Copyright (C) 2008-2012 Lars Otten
+ *  This file is part of DAOOPT.
+ *
+ *  DAOOPT is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  DAOOPT is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with DAOOPT.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Lars Otten <lotten@ics.uci.edu>
+ */
+
+#include "BoundChannel.h"
+
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#if defined(WINDOWS)
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
+namespace daoopt {
+
+BoundChannel::BoundChannel() : m_fd(NONE), m_bound(ELEM_NAN) {}
+
+BoundChannel::~BoundChannel() {
+#if !defined(WINDOWS)
+  if (m_fd != NONE)
+    close(m_fd);
+#endif
+}
+
+
+bool BoundChannel::open(const string& path) {
+  m_path = path;
+#if !defined(WINDOWS)
+  struct stat st;
+  if (stat(path.c_str(), &st))
+    return false;
+  if (S_ISFIFO(st.st_mode)) {
+    m_fd = ::open(path.c_str(), O_RDONLY | O_NONBLOCK);
+    return m_fd >= 0;
+  }
+#endif
+  return true;  // file channel, opened on every poll
+}
+
+
+bool BoundChannel::poll(double& d) {
+  double bound = m_bound;
+  if (m_fd != NONE) {
+#if !defined(WINDOWS)
+    char buf[256];
+    ssize_t r = 0;
+    while ((r = read(m_fd, buf, sizeof(buf))) > 0)
+      m_buffer.append(buf, r);
+    size_t n = m_buffer.size() / sizeof(double);
+    for (size_t i = 0; i < n; ++i) {
+      double x;
+      memcpy(&x, m_buffer.data() + i*sizeof(double), sizeof(double));
+      if (ISNAN(bound) || x > bound)
+        bound = x;
+    }
+    m_buffer.erase(0, n*sizeof(double));
+#endif
+  } else {
+    ifstream in(m_path.c_str());
+    double x = ELEM_NAN;
+    in >> x;
+    if (!in.fail() && (ISNAN(bound) || x > bound))
+      bound = x;
+  }
+
+  if (ISNAN(bound) || (!ISNAN(m_bound) && bound <= m_bound))
+    return false;
+  m_bound = d = bound;
+  return true;
+}
+
+
+bool BoundChannel::writePipe(int fd, double d) {
+#if defined(WINDOWS)
+  return false;
+#else
+  return write(fd, &d, sizeof(d)) == (ssize_t) sizeof(d);
+#endif
+}
+
+
+bool BoundChannel::writeFile(const string& path, double d) {
+  // Write to temporary file first, then move into place, so polling
+  // solvers never see a partial value.
+  oss tempname;
+  tempname << path << "-temp" << getpid();
+  ofstream out(tempname.str().c_str(), ios::out | ios::trunc);
+  out << setprecision(17) << d << endl;
+  out.close();
+  if (out.fail() || rename(tempname.str().c_str(), path.c_str())) {
+    remove(tempname.str().c_str());
+    return false;
+  }
+  return true;
+}
+
+}  // namespace daoopt
@@ -85,6 +85,14 @@ SearchNode* BoundPropagator::propagate(SearchNode* n, bool reportSolution, Searc
             propagateTuple(n,cur); // save (partial) opt. subproblem solution at current AND node
 #endif
         }
+#if defined PARALLEL_STATIC && !defined NO_ASSIGNMENT
+        else if (d == ELEM_ZERO) {
+          // frontier siblings are open concurrently: an OR child with only
+          // dead ends so far doesn't mean this AND node is done, so save the
+          // partial solution for when that sibling gets solved
+          propagateTuple(n,cur);
+        }
+#endif
 
       }
 
@@ -268,7 +276,9 @@ SearchNode* BoundPropagator::propagate(SearchNode* n, bool reportSolution, Searc
 #ifndef NO_ASSIGNMENT
 
 /* collects the joint assignment from 'start' upwards until 'end' and
- * records it into 'end' for later use */
+ * records it into 'end' for later use. Values found closer to 'start'
+ * take precedence: a partial assignment saved higher up might still hold
+ * values from an earlier (e.g. pruned) branch of the current path */
 void BoundPropagator::propagateTuple(SearchNode* start, SearchNode* end) {
   assert(start && end);
   DIAG(ostringstream ss; ss << "< REC opt. assignment from " << *start << " to " << *end << endl; myprint(ss.str());)
@@ -281,6 +291,8 @@ void BoundPropagator::propagateTuple(SearchNode* start, SearchNode* end) {
   // allocate assignment in end node
   vector<val_t>& assig = end->getOptAssig();
   assig.resize(endSubprob.size(), UNKNOWN);
+  // variables already recorded in this call
+  vector<bool> recorded(endSubprob.size(), false);
 
   int curVar = UNKNOWN, curVal = UNKNOWN;
   for (SearchNode* cur=start; cur!=end; cur=cur->getParent()) {
@@ -288,8 +300,10 @@ void BoundPropagator::propagateTuple(SearchNode* start, SearchNode* end) {
 
     if (cur->getType() == NODE_AND) {
       curVal = cur->getVal();
-      if (curVal!=UNKNOWN)
+      if (curVal!=UNKNOWN) {
         assig.at(endVarMap.at(curVar)) = curVal;
+        recorded.at(endVarMap.at(curVar)) = true;
+      }
     }
 
     if (cur->getOptAssig().size()) {
@@ -299,8 +313,10 @@ void BoundPropagator::propagateTuple(SearchNode* start, SearchNode* end) {
       vector<val_t>::const_iterator itVal = cur->getOptAssig().begin();
 
       for(; itVar!= curSubprob.end(); ++itVar, ++itVal ) {
-        if (*itVal != UNKNOWN)
+        if (*itVal != UNKNOWN && !recorded[endVarMap[*itVar]]) {
           assig[endVarMap[*itVar]] = *itVal;
+          recorded[endVarMap[*itVar]] = true;
+        }
       }
 
       // clear optimal assignment of AND node, since now propagated upwards
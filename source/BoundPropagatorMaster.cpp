@@ -24,6 +24,7 @@
 #undef DEBUG
 
 #include "BoundPropagatorMaster.h"
+#include "BoundChannel.h"
 
 namespace daoopt {
 
@@ -32,87 +33,85 @@ namespace daoopt {
 void BoundPropagatorMaster::operator() () {
 
   bool allDone = false;
-  size_t noPropagated = 0;
+  vector<SearchNode*> nodes;
+  vector<Subproblem*> subprobs;
 
   try { while (!allDone) {
 
+    { // wait for something to propagate
+      GETLOCK(m_spaceMaster->mtx_solved, lk);
+      while( m_spaceMaster->solved.empty() && m_spaceMaster->leaves.empty() ) {
+        CONDWAIT(m_spaceMaster->cond_solved, lk);
+      }
+    } // mtx_solved released
+
+    // take everything that is available as one batch, producers are never blocked
+    nodes.clear();
+    subprobs.clear();
     SearchNode* n = NULL;
     Subproblem* sp = NULL;
-    bool hasMore = false;
-    noPropagated = 0;
-    boost::thread* tp = NULL;
+    while (m_spaceMaster->leaves.pop(n))
+      nodes.push_back(n);
+    while (m_spaceMaster->solved.pop(sp))
+      subprobs.push_back(sp);
+
+    for (vector<Subproblem*>::iterator it = subprobs.begin(); it != subprobs.end(); ++it) {
+      sp = *it;
+      nodes.push_back(sp->root); // root node of subproblem
+
+      { // collect subproblem statistics
+        GETLOCK(m_spaceMaster->mtx_stats, lk);
+        m_spaceMaster->avgStats->addSubprob(sp);
+      }
 
-    do {
+      // clean up processing thread (joined outside of the lock, it might
+      // still be finishing up after reporting its result)
+      boost::thread* tp = NULL;
       {
-        GETLOCK(m_spaceMaster->mtx_solved, lk);
-
-        while( m_spaceMaster->solved.empty() && m_spaceMaster->leaves.empty() ) {
-          CONDWAIT(m_spaceMaster->cond_solved, lk);
+        GETLOCK(m_spaceMaster->mtx_activeThreads, lk);
+        map< Subproblem*, boost::thread* >::iterator itT = m_spaceMaster->activeThreads.find(sp);
+        if (itT != m_spaceMaster->activeThreads.end()) {
+          tp = itT->second;
+          m_spaceMaster->activeThreads.erase(itT);
         }
-
-        if (m_spaceMaster->leaves.size()) {
-          // new leaf node to propagate
-          n = m_spaceMaster->leaves.front();
-          m_spaceMaster->leaves.pop();
-        } else if (m_spaceMaster->solved.size()) {
-          // new externally solved subproblem
-          sp = m_spaceMaster->solved.front();
-          n = sp->root; // root node of subproblem
-
-          // collect subproblem statistics
-          {
-//            myprint("Adding subproblem to statistics\n");
-            GETLOCK(m_spaceMaster->mtx_stats, lk2);
-//            myprint("Acquired mutex\n");
-            m_spaceMaster->avgStats->addSubprob(sp);
-          }
-
-          { // clean up processing thread
-            GETLOCK(m_spaceMaster->mtx_activeThreads, lk2);
-            map< Subproblem*, boost::thread* >::iterator it = m_spaceMaster->activeThreads.find(sp);
-            if (it!=m_spaceMaster->activeThreads.end()) {
-              // tp = m_space->activeThreads.find(p)->second;
-              tp = it->second;
-              m_spaceMaster->activeThreads.erase(sp);
-              tp->join();
-              delete tp;
-            }
-          }
-
-          delete sp;
-          m_spaceMaster->solved.pop();
-        }
-
-      } // mtx_solved released
-
-      { // actual propagation
-        GETLOCK(m_spaceMaster->mtx_space, lk);
-        propagate(n, true);
-        ++noPropagated;
       }
-
-      { //check if there's more to propagate
-        GETLOCK(m_spaceMaster->mtx_solved, lk);
-        hasMore = !m_spaceMaster->solved.empty() || !m_spaceMaster->leaves.empty();
+      if (tp) {
+        tp->join();
+        delete tp;
       }
+    }
 
-    } while (hasMore);
+    double bound;
+    { // actual propagation, a single lock of the search space for the batch
+      GETLOCK(m_spaceMaster->mtx_space, lk);
+      for (vector<SearchNode*>::iterator it = nodes.begin(); it != nodes.end(); ++it)
+        propagate(*it, true);
+      bound = m_spaceMaster->root->getValue();
+    }
 
+    for (vector<Subproblem*>::iterator it = subprobs.begin(); it != subprobs.end(); ++it)
+      delete *it;
 
+    { // broadcast improved global lower bound to running subproblems
+      GETLOCK(m_spaceMaster->mtx_bound, lk);
+      if (!ISNAN(bound) && (ISNAN(m_spaceMaster->globalBound) || bound > m_spaceMaster->globalBound)) {
+        m_spaceMaster->globalBound = bound;
+        if (!m_spaceMaster->boundFile.empty())
+          BoundChannel::writeFile(m_spaceMaster->boundFile, bound);
+      }
+    }
 
-    { // TODO: Make sure race condition can't happen
+    {
       GETLOCK(m_spaceMaster->mtx_searchDone,lk);
       if (m_spaceMaster->searchDone) { // search process done?
+        // leaves are pushed before searchDone is set, so they're visible here
         GETLOCK(m_spaceMaster->mtx_activeThreads,lk2);
-        if (m_spaceMaster->activeThreads.empty()) { // no more processing threads
-          allDone = true;
-        }
-      } else { // search not done, notify
-        { // notify the search that the buffer is open again
-          GETLOCK(m_spaceMaster->mtx_allowedThreads,lk);
-          m_spaceMaster->allowedThreads += noPropagated;
-          m_spaceMaster->cond_allowedThreads.notify_one();
-        }
+        allDone = m_spaceMaster->activeThreads.empty()  // no more processing threads
+            && m_spaceMaster->leaves.empty() && m_spaceMaster->solved.empty();
+      } else { // search not done, notify right away that the buffer is open again
+        GETLOCK(m_spaceMaster->mtx_allowedThreads,lk2);
+        m_spaceMaster->allowedThreads += nodes.size();
+        m_spaceMaster->cond_allowedThreads.notify_one();
       }
     }
 
@@ -120,6 +120,9 @@ void BranchAndBoundMaster::solveLocal(SearchNode* node) const {
   reverse(pst.begin(), pst.end()); // reverse to make it top-down
 
   bab.restrictSubproblem(node->getVar(), m_assignment , pst );
+#ifndef NO_HEURISTIC
+  bab.finalizeHeuristic();
+#endif
 
   BoundPropagator prop(m_problem,&sp);
 
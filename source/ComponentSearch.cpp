@@ -0,0 +1,141 @@
+/*
+ * ComponentSearch.cpp
+ *
+ *  Copyright (C) 2008-2012 Lars Otten
+ *  This file is part of DAOOPT.
+ *
+ *  DAOOPT is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  DAOOPT is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with DAOOPT.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Lars Otten <lotten@ics.uci.edu>
+ */
+
+
+
+#include "ComponentSearch.h"
+
+#if not (defined PARALLEL_DYNAMIC || defined PARALLEL_STATIC || defined NOTHREADS)
+
+#include "BoundPropagator.h"
+#include "BranchAndBound.h"
+
+namespace daoopt {
+
+/* orders components by decreasing size */
+static bool largerComponent(const ComponentJob& a, const ComponentJob& b) {
+  return a.size > b.size;
+}
+
+
+ComponentSearch::ComponentSearch(Problem* p, Pseudotree* pt, Heuristic* h, ProgramOptions* opt) :
+    m_problem(p), m_pseudotree(pt), m_heuristic(h), m_options(opt), m_next(0) {
+  assert(p && pt && h && opt);
+  BOOST_FOREACH( PseudotreeNode* c, m_pseudotree->getRoot()->getChildren() ) {
+    m_jobs.push_back(ComponentJob(c->getVar(), c->getSubprobSize()));
+  }
+  stable_sort(m_jobs.begin(), m_jobs.end(), largerComponent);
+}
+
+
+void ComponentSearch::run(int threads) {
+  m_next = 0;
+  threads = max(1, min(threads, (int) m_jobs.size()));
+  boost::thread_group group;
+  for (int i = 0; i < threads; ++i)
+    group.create_thread(ComponentThread(this));
+  group.join_all();
+}
+
+
+void ComponentSearch::work() {
+  while (true) {
+    size_t i;
+    {
+      boost::mutex::scoped_lock lock(m_mtx);
+      if (m_next >= m_jobs.size())
+        return;
+      i = m_next++;
+    }
+    solve(m_jobs[i]);
+  }
+}
+
+
+void ComponentSearch::solve(ComponentJob& job) const {
+  // restricting modifies the pseudo tree, so work on a copy
+  Pseudotree pt(*m_pseudotree);
+  SearchSpace space(&pt, m_options);
+  BranchAndBound bab(m_problem, &pt, &space, m_heuristic);
+
+  // the component has no context, its dummy parent holds no bound
+  vector<val_t> assig(m_problem->getN(), NONE);
+  assig[m_problem->getN()-1] = 0;
+  vector<double> pst(2);
+  pst[0] = ELEM_ZERO;
+  pst[1] = ELEM_ONE;
+  job.depth = bab.restrictSubproblem(job.root, assig, pst);
+#ifndef NO_HEURISTIC
+  bab.finalizeHeuristic();
+#endif
+
+  // no solution reporting, the solutions are combined in the end
+  BoundPropagator prop(m_problem, &space, !m_options->nocaching);
+  SearchNode* n = bab.nextLeaf();
+  while (n) {
+    // a root that is a leaf right away (e.g. dead end) would get deleted
+    if (n != space.subproblemLocal)
+      prop.propagate(n);
+    n = bab.nextLeaf();
+  }
+
+  job.value = bab.getCurOptValue();
+#ifndef NO_ASSIGNMENT
+  job.tuple = bab.getCurOptTuple();
+#endif
+  job.stats = space.stats;
+  job.nodeP = bab.getNodeProfile();
+  job.leafP = bab.getLeafProfile();
+}
+
+
+double ComponentSearch::getSolutionCost() const {
+  // functions at the dummy root have no other variable in their scope
+  vector<val_t> assig(m_problem->getN(), 0);
+  double cost = ELEM_ONE;
+  BOOST_FOREACH( Function* f, m_pseudotree->getRoot()->getFunctions() ) {
+    cost OP_TIMESEQ f->getValue(assig);
+  }
+  BOOST_FOREACH( const ComponentJob& job, m_jobs ) {
+    if (ISNAN(job.value))
+      return ELEM_NAN;
+    cost OP_TIMESEQ job.value;
+  }
+  return cost;
+}
+
+
+#ifndef NO_ASSIGNMENT
+void ComponentSearch::getSolution(vector<val_t>& tuple) const {
+  tuple.assign(m_problem->getN(), 0);  // includes the dummy variable
+  BOOST_FOREACH( const ComponentJob& job, m_jobs ) {
+    const vector<int>& vars = m_pseudotree->getNode(job.root)->getSubprobVars();
+    for (size_t k = 0; k < vars.size() && k < job.tuple.size(); ++k)
+      tuple[vars[k]] = job.tuple[k];
+  }
+}
+#endif
+
+}  // namespace daoopt
+
+#endif /* not parallel, threads */
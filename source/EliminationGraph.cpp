@@ -0,0 +1,370 @@
+/*
+ * EliminationGraph.cpp
+ *
+ *  Copyright (C) 2008-2012 Lars Otten
+ *  This file is part of DAOOPT.
+ *
+ *  DAOOPT is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  DAOOPT is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with DAOOPT.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Lars Otten <lotten@ics.uci.edu>
+ */
+
+#include "EliminationGraph.h"
+
+namespace daoopt {
+
+EliminationGraph::EliminationGraph(Graph G) : m_n(0), m_words(0), m_remaining(0),
+    m_heapSize(0), m_stamp(0), m_objective(ORDER_OBJ_WIDTH), m_cbound(NONE), m_cost(0.0) {
+
+  const set<int> nodes = G.getNodes();
+  if (nodes.size())
+    m_n = *nodes.rbegin() + 1;
+  m_words = (m_n + 63) / 64;
+
+  m_adjInit.resize(m_n * m_words, 0);
+  m_degreeInit.resize(m_n, 0);
+  m_scoreInit.resize(m_n, 0);
+  m_present.resize(m_n, false);
+
+  for (set<int>::const_iterator it = nodes.begin(); it != nodes.end(); ++it) {
+    m_present[*it] = true;
+    const set<int>& N = G.getNeighbors(*it);
+    word_t* row = &m_adjInit[(*it) * m_words];
+    for (set<int>::const_iterator itN = N.begin(); itN != N.end(); ++itN)
+      row[*itN / 64] |= word_t(1) << (*itN % 64);
+    m_degreeInit[*it] = N.size();
+  }
+
+  // allocate working arrays once, reused by every elimination
+  m_adj = m_adjInit;
+  m_degree = m_degreeInit;
+  m_score.resize(m_n, 0);
+  m_key.resize(m_n, 0);
+  m_heap.resize(m_n, NONE);
+  m_pos.resize(m_n, NONE);
+  m_mark.resize(m_n, 0);
+  m_nbr.reserve(m_n);
+  m_update.reserve(m_n);
+  m_ties.reserve(m_n);
+  m_subHeight.resize(m_n, 0);
+
+  // initial minfill scores: no. of non-adjacent pairs of neighbors
+  for (int i = 0; i < m_n; ++i) {
+    if (!m_present[i]) continue;
+    getNeighbors(i, m_nbr);
+    nCost c = 0;
+    for (vector<int>::const_iterator it = m_nbr.begin(); it != m_nbr.end(); ++it)
+      c += m_degree[i] - 1 - commonNeighbors(i, *it);
+    m_scoreInit[i] = c / 2;
+  }
+}
+
+
+void EliminationGraph::setObjective(int objective, const vector<val_t>& domains, int cbound) {
+  m_objective = objective;
+  m_cbound = cbound;
+  m_domain.assign(m_n, 1.0);
+  for (int i = 0; i < m_n && i < (int) domains.size(); ++i)
+    m_domain[i] = domains[i];
+  m_ctxDomains.reserve(m_n);
+}
+
+
+void EliminationGraph::reset() {
+  copy(m_adjInit.begin(), m_adjInit.end(), m_adj.begin());
+  copy(m_degreeInit.begin(), m_degreeInit.end(), m_degree.begin());
+  copy(m_scoreInit.begin(), m_scoreInit.end(), m_score.begin());
+  copy(m_scoreInit.begin(), m_scoreInit.end(), m_key.begin());
+
+  fill(m_subHeight.begin(), m_subHeight.end(), 0);
+  m_cost = 0.0;
+
+  // nodes are inserted in order of (score, index), which is a valid heap
+  m_heapSize = 0;
+  m_remaining = 0;
+  for (int i = 0; i < m_n; ++i) {
+    m_pos[i] = NONE;
+    if (!m_present[i]) continue;
+    m_heap[m_heapSize] = i;
+    m_pos[i] = m_heapSize++;
+    heapUp(m_pos[i]);
+    ++m_remaining;
+  }
+}
+
+
+int EliminationGraph::eliminate(vector<int>& elim, int limit, RandStream* rs,
+                                double costLimit) {
+
+  int width = UNKNOWN;
+
+  elim.clear();
+  elim.reserve(m_n);
+  this->reset();
+
+  while (m_remaining) {
+
+    // eliminate all nodes with score=0 -> no edges will have to be added.
+    // scores of their neighbors are updated internally, but not in the heap
+    // (same as the reference implementation in Pseudotree::eliminate)
+    m_ties.clear();
+    if (m_heapSize && m_key[m_heap[0]] == 0)
+      collectTies();
+    for (vector<int>::const_iterator it = m_ties.begin(); it != m_ties.end(); ++it) {
+      elim.push_back(*it);
+      width = max(width, m_degree[*it]);
+      if (m_objective != ORDER_OBJ_WIDTH)
+        account(*it);
+      heapRemove(*it);
+      removeNode(*it);
+    }
+
+    // anything left to eliminate? If not, we are done!
+    if (!m_heapSize)
+      return width;
+
+    // Pick one of the minimal score nodes, breaking ties randomly
+    collectTies();
+    int next = m_ties.at(rs ? rs->next(m_ties.size()) : rand::next(m_ties.size()));
+    elim.push_back(next);
+
+    // update width of implied tree decomposition
+    width = max(width, m_degree[next]);
+
+    // update objective
+    account(next);
+
+    // early termination condition: width or objective above given limit
+    if (width > limit || m_cost > costLimit)
+      return INT_MAX;
+
+    // connect neighbors in primal graph
+    connectNeighbors();
+
+    // candidates for key update: node's neighbors and their neighbors
+    ++m_stamp;
+    m_mark[next] = m_stamp;
+    m_update.clear();
+    for (vector<int>::const_iterator it = m_nbr.begin(); it != m_nbr.end(); ++it) {
+      const word_t* row = &m_adj[(*it) * m_words];
+      if (m_mark[*it] != m_stamp) {
+        m_mark[*it] = m_stamp;
+        m_update.push_back(*it);
+      }
+      for (size_t k = 0; k < m_words; ++k) {
+        for (word_t w = row[k]; w; w &= w - 1) {
+          int x = k * 64 + lowestBit64(w);
+          if (m_mark[x] != m_stamp) {
+            m_mark[x] = m_stamp;
+            m_update.push_back(x);
+          }
+        }
+      }
+    }
+
+    // remove node from primal graph
+    heapRemove(next);
+    removeNode(next);
+
+    // update heap keys of candidate nodes
+    for (vector<int>::const_iterator it = m_update.begin(); it != m_update.end(); ++it) {
+      m_key[*it] = m_score[*it];
+      heapUpdate(*it);
+    }
+  }
+
+  return width;
+}
+
+
+int EliminationGraph::evaluate(const vector<int>& elim) {
+  int width = UNKNOWN;
+  this->reset();
+  for (vector<int>::const_iterator it = elim.begin(); it != elim.end(); ++it) {
+    if (*it >= m_n || !m_present[*it])
+      continue;
+    width = max(width, m_degree[*it]);
+    account(*it);
+    connectNeighbors();
+    removeNode(*it);
+  }
+  return width;
+}
+
+
+void EliminationGraph::account(int i) {
+  getNeighbors(i, m_nbr);
+  if (m_objective == ORDER_OBJ_STATESPACE) {
+    double s = m_domain[i];
+    for (vector<int>::const_iterator it = m_nbr.begin(); it != m_nbr.end(); ++it)
+      s *= m_domain[*it];
+    m_cost += s;
+  } else if (m_objective == ORDER_OBJ_CACHE) {
+    // neighbors at elimination time form the node's context
+    m_ctxDomains.clear();
+    for (vector<int>::const_iterator it = m_nbr.begin(); it != m_nbr.end(); ++it)
+      m_ctxDomains.push_back(m_domain[*it]);
+    size_t c = m_ctxDomains.size();
+    if (m_cbound != NONE && (int) c > m_cbound) {
+      c = m_cbound;  // adaptive caching, bound by largest domains
+      partial_sort(m_ctxDomains.begin(), m_ctxDomains.begin() + c,
+                   m_ctxDomains.end(), greater<double>());
+    }
+    double entries = 1.0;
+    for (size_t k = 0; k < c; ++k)
+      entries *= m_ctxDomains[k];
+    m_cost += entries * (sizeof(double) + c * sizeof(val_t));
+  } else if (m_objective == ORDER_OBJ_HEIGHT) {
+    // all neighbors are ancestors of i in the pseudo tree
+    int h = m_subHeight[i];
+    for (vector<int>::const_iterator it = m_nbr.begin(); it != m_nbr.end(); ++it)
+      m_subHeight[*it] = max(m_subHeight[*it], h + 1);
+    m_cost = max(m_cost, (double) h);
+  }
+}
+
+
+void EliminationGraph::connectNeighbors() {
+  for (size_t i = 0; i < m_nbr.size(); ++i) {
+    const word_t* row = &m_adj[m_nbr[i] * m_words];
+    for (size_t j = i+1; j < m_nbr.size(); ++j) {
+      if (!(row[m_nbr[j] / 64] & (word_t(1) << (m_nbr[j] % 64))))
+        addEdge(m_nbr[i], m_nbr[j]);
+    }
+  }
+}
+
+
+void EliminationGraph::addEdge(int i, int j) {
+  int c = commonNeighbors(i, j);
+  // new non-adjacent pairs (j,x) in N(i) and (i,x) in N(j)
+  m_score[i] += m_degree[i] - c;
+  m_score[j] += m_degree[j] - c;
+  // pair (i,j) now adjacent in all common neighborhoods
+  const word_t* a = &m_adj[i*m_words];
+  const word_t* b = &m_adj[j*m_words];
+  for (size_t k = 0; k < m_words; ++k) {
+    for (word_t w = a[k] & b[k]; w; w &= w - 1)
+      m_score[k * 64 + lowestBit64(w)] -= 1;
+  }
+  m_adj[i*m_words + j/64] |= word_t(1) << (j % 64);
+  m_adj[j*m_words + i/64] |= word_t(1) << (i % 64);
+  ++m_degree[i];
+  ++m_degree[j];
+}
+
+
+void EliminationGraph::removeNode(int i) {
+  getNeighbors(i, m_nbr);
+  for (vector<int>::const_iterator it = m_nbr.begin(); it != m_nbr.end(); ++it) {
+    // non-adjacent pairs (i,x) in N(u) disappear
+    int u = *it;
+    m_score[u] -= m_degree[u] - 1 - commonNeighbors(i, u);
+    m_adj[u*m_words + i/64] &= ~(word_t(1) << (i % 64));
+    --m_degree[u];
+  }
+  fill(m_adj.begin() + i*m_words, m_adj.begin() + (i+1)*m_words, word_t(0));
+  m_degree[i] = 0;
+  --m_remaining;
+}
+
+
+void EliminationGraph::getNeighbors(int i, vector<int>& out) const {
+  out.clear();
+  const word_t* row = &m_adj[i*m_words];
+  for (size_t k = 0; k < m_words; ++k) {
+    for (word_t w = row[k]; w; w &= w - 1)
+      out.push_back(k * 64 + lowestBit64(w));
+  }
+}
+
+
+void EliminationGraph::heapUp(int p) {
+  int i = m_heap[p];
+  while (p > 0) {
+    int q = (p - 1) / 2;
+    if (!heapLess(i, m_heap[q]))
+      break;
+    m_heap[p] = m_heap[q];
+    m_pos[m_heap[p]] = p;
+    p = q;
+  }
+  m_heap[p] = i;
+  m_pos[i] = p;
+}
+
+
+void EliminationGraph::heapDown(int p) {
+  int i = m_heap[p];
+  while (true) {
+    int c = 2 * p + 1;
+    if (c >= m_heapSize)
+      break;
+    if (c + 1 < m_heapSize && heapLess(m_heap[c+1], m_heap[c]))
+      ++c;
+    if (!heapLess(m_heap[c], i))
+      break;
+    m_heap[p] = m_heap[c];
+    m_pos[m_heap[p]] = p;
+    p = c;
+  }
+  m_heap[p] = i;
+  m_pos[i] = p;
+}
+
+
+void EliminationGraph::heapRemove(int i) {
+  int p = m_pos[i];
+  assert(p != NONE);
+  m_pos[i] = NONE;
+  if (--m_heapSize == p)
+    return;
+  int j = m_heap[m_heapSize];  // move last element into gap
+  m_heap[p] = j;
+  m_pos[j] = p;
+  heapUp(p);
+  heapDown(m_pos[j]);
+}
+
+
+void EliminationGraph::heapUpdate(int i) {
+  int p = m_pos[i];
+  if (p == NONE)
+    return;
+  heapUp(p);
+  heapDown(m_pos[i]);
+}
+
+
+void EliminationGraph::collectTies() {
+  assert(m_heapSize);
+  m_ties.clear();
+  nCost k = m_key[m_heap[0]];
+  // nodes with minimal key form a subtree at the heap's root
+  m_nbr.clear();
+  m_nbr.push_back(0);
+  while (!m_nbr.empty()) {
+    int p = m_nbr.back();
+    m_nbr.pop_back();
+    m_ties.push_back(m_heap[p]);
+    for (int c = 2*p+1; c <= 2*p+2 && c < m_heapSize; ++c) {
+      if (m_key[m_heap[c]] == k)
+        m_nbr.push_back(c);
+    }
+  }
+  sort(m_ties.begin(), m_ties.end());
+}
+
+}  // namespace daoopt
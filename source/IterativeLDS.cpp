@@ -0,0 +1,163 @@
+/*
+ * IterativeLDS.cpp
+ *
+ *  Copyright (C) 2008-2012 Lars Otten
+ *  This file is part of DAOOPT.
+ *
+ *  DAOOPT is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  DAOOPT is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with DAOOPT.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Lars Otten <lotten@ics.uci.edu>
+ */
+
+#include "IterativeLDS.h"
+
+#ifndef NOTHREADS
+
+#include "BoundChannel.h"
+#include "BoundPropagator.h"
+
+namespace daoopt {
+
+void IterativeLDS::run(int threads) {
+  m_bound = m_problem->getSolutionCost();
+#ifndef NO_ASSIGNMENT
+  m_tuple = m_problem->getSolutionAssg();
+#endif
+
+  boost::thread_group group;
+  for (int i = 0; i < min(threads, m_maxDisc + 1); ++i)
+    group.create_thread(IterativeLDSThread(this));
+  group.join_all();
+}
+
+
+void IterativeLDS::work() {
+  while (true) {
+    int disc;
+    {
+      boost::mutex::scoped_lock lock(m_mtx);
+      if (m_stop || m_nextDisc > m_maxDisc)
+        return;
+      disc = m_nextDisc++;
+    }
+    if (!runLimit(disc))
+      return;
+  }
+}
+
+
+bool IterativeLDS::runLimit(int disc) {
+  SearchSpace space(m_pseudotree, m_options);
+  LimitedDiscrepancy lds(m_problem, m_pseudotree, &space, m_heuristic, disc);
+  size_t version;
+  {
+    // one instance at a time reads the subproblem file and the incumbent
+    boost::mutex::scoped_lock lock(m_mtx);
+    if (!m_options->in_subproblemFile.empty()
+        && !lds.restrictSubproblem(m_options->in_subproblemFile)) {
+      err_txt("Subproblem restriction for LDS failed.");
+      m_stop = true;
+      return false;
+    }
+    version = m_boundVersion;
+    lds.updateSolution(m_bound
+#ifndef NO_ASSIGNMENT
+        , m_tuple
+#endif
+    );
+#ifndef NO_HEURISTIC
+    lds.finalizeHeuristic();
+#endif
+  }
+
+  BoundPropagator prop(m_problem, &space, false);  // doCaching = false
+  double best = lds.getCurOptValue();
+  bool complete = true;
+  SearchNode* n = lds.nextLeaf();
+  for (count_t leaves = 1; n; ++leaves) {
+    prop.propagate(n);  // solutions are reported through report()
+    double d = lds.getCurOptValue();
+    if (!ISNAN(d) && (ISNAN(best) || d > best)) {
+      best = d;
+      report(d,
+#ifndef NO_ASSIGNMENT
+             lds.getCurOptTuple(),
+#endif
+             &space.stats);
+    }
+    if (leaves % BOUND_POLL_INTERVAL == 0) {
+      if (!poll(lds, version)) {
+        complete = false;  // time's up
+        break;
+      }
+      best = lds.getCurOptValue();
+    }
+    n = lds.nextLeaf();
+  }
+
+  boost::mutex::scoped_lock lock(m_mtx);
+  m_numOR += space.stats.numExpOR;
+  m_numAND += space.stats.numExpAND;
+  if (complete) {
+    m_done[disc] = true;
+    while (m_doneDisc <= m_maxDisc && m_done[m_doneDisc])
+      ++m_doneDisc;
+  }
+  return complete;
+}
+
+
+bool IterativeLDS::report(double d,
+#ifndef NO_ASSIGNMENT
+                          const vector<val_t>& tuple,
+#endif
+                          const SearchStats* stats) {
+  boost::mutex::scoped_lock lock(m_mtx);
+  if (!ISNAN(m_bound) && d <= m_bound)
+    return false;
+  m_bound = d;
+#ifndef NO_ASSIGNMENT
+  m_tuple = tuple;
+  m_problem->updateSolution(d, tuple, stats, true);
+#else
+  m_problem->updateSolution(d, stats, true);
+#endif
+  ++m_boundVersion;
+  return true;
+}
+
+
+bool IterativeLDS::poll(Search& lds, size_t& version) {
+  time_t now;
+  time(&now);
+  boost::mutex::scoped_lock lock(m_mtx);
+  if (m_options->ldsTime != NONE && difftime(now, m_timeStart) >= m_options->ldsTime)
+    m_stop = true;
+  if (m_stop)
+    return false;
+  if (version != m_boundVersion) {
+    version = m_boundVersion;
+    lds.updateSolution(m_bound
+#ifndef NO_ASSIGNMENT
+        , m_tuple
+#endif
+    );
+  }
+  return true;
+}
+
+}  // namespace daoopt
+
+#endif /* NOTHREADS */
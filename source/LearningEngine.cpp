@@ -23,6 +23,8 @@
 
 #include "LearningEngine.h"
 
+#include <iomanip>
+
 #ifdef PARALLEL_STATIC
 
 namespace daoopt {
@@ -46,6 +48,249 @@ void LearningEngine::statsToFile(const string& fn) const {
   of.close();
 }
 
+
+string LearningEngine::errorReport() const {
+  ostringstream ss;
+  if (m_samples.empty())
+    return ss.str();
+  double sqErr = 0.0, absErr = 0.0;
+  for (size_t i = 0; i < m_samples.size(); ++i) {
+    double err = predict(m_samples[i]) - target(m_samples[i]);
+    sqErr += err * err;
+    absErr += fabs(err);
+  }
+  ss << "Prediction error on " << m_samples.size() << " samples (log10 nodes): RMSE "
+     << sqrt(sqErr / m_samples.size()) << ", MAE " << absErr / m_samples.size() << endl;
+  return ss.str();
+}
+
+
+static inline bool isFinite(double x) {
+  return !ISNAN(x) && fabs(x) != numeric_limits<double>::infinity();
+}
+
+/* Cholesky factorization of the symmetric positive definite d x d matrix A
+ * (row-major) in place, lower triangle holds the factor. Returns false if
+ * A is not positive definite. */
+static bool choleskyDecomp(vector<double>& A, size_t d) {
+  for (size_t j = 0; j < d; ++j) {
+    double s = A[j*d+j];
+    for (size_t k = 0; k < j; ++k)
+      s -= A[j*d+k] * A[j*d+k];
+    if (s <= 0.0)
+      return false;
+    A[j*d+j] = sqrt(s);
+    for (size_t i = j+1; i < d; ++i) {
+      double t = A[i*d+j];
+      for (size_t k = 0; k < j; ++k)
+        t -= A[i*d+k] * A[j*d+k];
+      A[i*d+j] = t / A[j*d+j];
+    }
+  }
+  return true;
+}
+
+/* solves L L^T x = b in place, given the factor from choleskyDecomp() */
+static void choleskySolve(const vector<double>& L, size_t d, vector<double>& b) {
+  for (size_t i = 0; i < d; ++i) {
+    for (size_t k = 0; k < i; ++k)
+      b[i] -= L[i*d+k] * b[k];
+    b[i] /= L[i*d+i];
+  }
+  for (size_t i = d; i-- > 0; ) {
+    for (size_t k = i+1; k < d; ++k)
+      b[i] -= L[k*d+i] * b[k];
+    b[i] /= L[i*d+i];
+  }
+}
+
+
+void LinearRegressionLearner::standardize(const SubproblemStats& s, vector<double>& out) const {
+  s.getFeatures(out);
+  // features missing from the model are ignored, missing values count as mean
+  out.resize(m_mean.size(), 0.0);
+  for (size_t j = 0; j < out.size(); ++j) {
+    if (m_scale[j] > 0.0 && isFinite(out[j]))
+      out[j] = (out[j] - m_mean[j]) / m_scale[j];
+    else
+      out[j] = 0.0;
+  }
+}
+
+
+bool LinearRegressionLearner::trainModel() {
+  size_t n = m_samples.size();
+  if (n < 2)
+    return false;
+
+  vector<vector<double> > X(n);
+  vector<double> y(n);
+  for (size_t i = 0; i < n; ++i) {
+    m_samples[i].getFeatures(X[i]);
+    y[i] = target(m_samples[i]);
+    if (X[i].size() != X[0].size())
+      return false;  // inconsistent feature vectors
+  }
+  size_t d = X[0].size();
+
+  // per-feature mean and standard deviation (over finite values only)
+  m_mean.assign(d, 0.0);
+  m_scale.assign(d, 0.0);
+  for (size_t j = 0; j < d; ++j) {
+    double sum = 0.0, sqSum = 0.0;
+    size_t cnt = 0;
+    for (size_t i = 0; i < n; ++i) {
+      if (!isFinite(X[i][j]))
+        continue;
+      sum += X[i][j];
+      sqSum += X[i][j] * X[i][j];
+      ++cnt;
+    }
+    if (cnt == 0)
+      continue;
+    m_mean[j] = sum / cnt;
+    double var = sqSum / cnt - m_mean[j] * m_mean[j];
+    m_scale[j] = (var > 1e-12) ? sqrt(var) : 0.0;
+  }
+
+  m_intercept = 0.0;
+  for (size_t i = 0; i < n; ++i)
+    m_intercept += y[i];
+  m_intercept /= n;
+
+  // standardized features and centered targets; normal equations with
+  // ridge penalty (small minimum to keep the system positive definite)
+  vector<double> A(d*d, 0.0), b(d, 0.0);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < d; ++j)
+      X[i][j] = (m_scale[j] > 0.0 && isFinite(X[i][j])) ?
+          (X[i][j] - m_mean[j]) / m_scale[j] : 0.0;
+    for (size_t j = 0; j < d; ++j) {
+      b[j] += X[i][j] * (y[i] - m_intercept);
+      for (size_t k = 0; k <= j; ++k)
+        A[j*d+k] += X[i][j] * X[i][k];
+    }
+  }
+  for (size_t j = 0; j < d; ++j) {
+    A[j*d+j] += max(m_lambda, 1e-9);
+    for (size_t k = 0; k < j; ++k)
+      A[k*d+j] = A[j*d+k];
+  }
+
+  if (!choleskyDecomp(A, d)) {
+    m_weight.clear();
+    return false;
+  }
+  m_weight = b;
+  choleskySolve(A, d, m_weight);
+
+  // leave-one-out residuals via the diagonal of the hat matrix
+  m_looResidual.resize(n);
+  vector<double> z;
+  for (size_t i = 0; i < n; ++i) {
+    z = X[i];
+    choleskySolve(A, d, z);
+    double h = 1.0 / n, pred = m_intercept;
+    for (size_t j = 0; j < d; ++j) {
+      h += X[i][j] * z[j];
+      pred += X[i][j] * m_weight[j];
+    }
+    m_looResidual[i] = (h < 1.0) ? (y[i] - pred) / (1.0 - h) : 0.0;
+  }
+
+  return true;
+}
+
+
+double LinearRegressionLearner::predict(const SubproblemStats& s) const {
+  assert(isTrained());
+  vector<double> z;
+  standardize(s, z);
+  double pred = m_intercept;
+  for (size_t j = 0; j < z.size(); ++j)
+    pred += z[j] * m_weight[j];
+  return pred;
+}
+
+
+string LinearRegressionLearner::errorReport() const {
+  ostringstream ss;
+  ss << "Linear regression model with " << m_weight.size() << " features, lambda "
+     << m_lambda << endl;
+  ss << LearningEngine::errorReport();
+  if (!m_looResidual.empty()) {
+    double sqErr = 0.0;
+    for (size_t i = 0; i < m_looResidual.size(); ++i)
+      sqErr += m_looResidual[i] * m_looResidual[i];
+    ss << "Leave-one-out RMSE (log10 nodes): " << sqrt(sqErr / m_looResidual.size()) << endl;
+  }
+  return ss.str();
+}
+
+
+bool LinearRegressionLearner::modelToFile(const string& fn) const {
+  if (!isTrained())
+    return false;
+  ofstream of(fn.c_str(), ios_base::out | ios_base::trunc);
+  if (!of)
+    return false;
+  of << setprecision(17);
+  of << "# linear regression of log10 subproblem size, "
+     << m_samples.size() << " samples" << endl;
+  of << "lambda " << m_lambda << endl;
+  of << "intercept " << m_intercept << endl;
+  of << "features " << m_weight.size() << endl;
+  of << "# mean\tscale\tweight" << endl;
+  for (size_t j = 0; j < m_weight.size(); ++j)
+    of << m_mean[j] << '\t' << m_scale[j] << '\t' << m_weight[j] << endl;
+  of.close();
+  return !of.fail();
+}
+
+
+bool LinearRegressionLearner::modelFromFile(const string& fn) {
+  ifstream in(fn.c_str());
+  if (!in)
+    return false;
+  string line, key;
+  size_t d = 0;
+  double lambda = 0.0, intercept = 0.0;
+  vector<double> mean, scale, weight;
+  while (getline(in, line)) {
+    if (line.empty() || line[0] == '#')
+      continue;
+    istringstream iss(line);
+    if (isdigit(line[0]) || line[0] == '-' || line[0] == '.') {
+      double m, s, w;
+      if (!(iss >> m >> s >> w))
+        return false;
+      mean.push_back(m);
+      scale.push_back(s);
+      weight.push_back(w);
+      continue;
+    }
+    iss >> key;
+    if (key == "lambda")
+      iss >> lambda;
+    else if (key == "intercept")
+      iss >> intercept;
+    else if (key == "features")
+      iss >> d;
+    else
+      return false;
+  }
+  if (d == 0 || weight.size() != d)
+    return false;
+
+  m_lambda = lambda;
+  m_intercept = intercept;
+  m_mean.swap(mean);
+  m_scale.swap(scale);
+  m_weight.swap(weight);
+  m_looResidual.clear();
+  return true;
+}
+
 }  // namespace daoopt
 
 #endif  /* PARALLEL_STATIC */
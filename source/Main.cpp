@@ -34,6 +34,16 @@ namespace daoopt {
 
 time_t _time_start, _time_pre;
 
+
+/* constructor and destructor out of line, the CVO graph is only complete here */
+Main::Main() : m_solved(false), m_subprobId(NONE) {
+  /* nothing here */
+}
+
+Main::~Main() {
+  /* nothing here */
+}
+
 bool Main::parseOptions(int argc, char** argv) {
   // Reprint command line
   for (int i=0; i<argc; ++i)
@@ -107,39 +117,47 @@ bool Main::loadProblem() {
 }
 
 
+bool Main::preprocess() {
+#ifndef NOTHREADS
+  if (!m_options->nopipeline && !m_options->nosearch) {
+    if (!prepareOrdering())
+      return false;
+    cout << "Searching for elimination ordering in the background." << endl;
+    bool ordered = false;
+    boost::thread orderThread(OrderingStageThread(this, &ordered));
+    bool success = preprocessHeuristic() && runSLS();
+    orderThread.join();
+    return success && ordered && finishOrdering();
+  }
+#endif
+  return preprocessHeuristic() && runSLS() && findOrLoadOrdering();
+}
+
+
 bool Main::findOrLoadOrdering() {
+  return prepareOrdering() && searchOrdering() && finishOrdering();
+}
+
+
+bool Main::prepareOrdering() {
   // Create primal graph of *reduced* problem
-  Graph g(m_problem->getN());
+  m_graph.reset(new Graph(m_problem->getN()));
   const vector<Function*>& fns = m_problem->getFunctions();
   for (vector<Function*>::const_iterator it = fns.begin(); it != fns.end(); ++it) {
-    g.addClique((*it)->getScopeVec());
+    m_graph->addClique((*it)->getScopeVec());
   }
-  cout << "Graph with " << g.getStatNodes() << " nodes and "
-       << g.getStatEdges() << " edges created." << endl;
-
-  scoped_ptr<ARE::Graph> cvoGraph;
-  scoped_ptr<ARE::Graph> cvoMasterGraph;
-  scoped_ptr<CMauiAVLTreeSimple> cvoAvlVars2CheckScore;
-  scoped_ptr<ARE::AdjVarMemoryDynamicManager> cvoTempAdjVarSpace;
+  cout << "Graph with " << m_graph->getStatNodes() << " nodes and "
+       << m_graph->getStatEdges() << " edges created." << endl;
 
   if (m_options->order_cvo) {
     vector< const vector<int>* > fn_signatures;
     BOOST_FOREACH( Function* f, m_problem->getFunctions() )
       { fn_signatures.push_back(& f->getScopeVec()); }
 
-    cvoMasterGraph.reset(new ARE::Graph);
-    cvoMasterGraph->Create(m_problem->getN(), fn_signatures);
-    if (!cvoMasterGraph->_IsValid)
+    m_cvoGraph.reset(new ARE::Graph);
+    m_cvoGraph->Create(m_problem->getN(), fn_signatures);
+    if (!m_cvoGraph->_IsValid)
       return false;
-
-    cvoAvlVars2CheckScore.reset(new CMauiAVLTreeSimple);
-    cvoTempAdjVarSpace.reset(new ARE::AdjVarMemoryDynamicManager(ARE_TempAdjVarSpaceSize));
-
-    cvoMasterGraph->ComputeVariableEliminationOrder_Simple_wMinFillOnly(
-        INT_MAX, false, true, 10, -1, 0.0, *cvoAvlVars2CheckScore, *cvoTempAdjVarSpace);
-    cvoMasterGraph->ReAllocateEdges();
-
-    cvoGraph.reset(new ARE::Graph);
   }
 
 #ifdef PARALLEL_STATIC
@@ -152,6 +170,30 @@ bool Main::findOrLoadOrdering() {
   }
 #endif
 
+  // Persistent ordering cache, keyed by structure of the reduced problem
+  if (!m_options->in_orderingCache.empty()) {
+    m_orderCache.reset(new OrderingCache(m_options->in_orderingCache, m_problem.get(),
+                                         m_options->order_objective));
+  }
+  return true;
+}
+
+
+bool Main::searchOrdering(bool quiet) {
+  // all output is deferred to finishOrdering() if quiet
+  oss log;
+  ostream& out = quiet ? static_cast<ostream&>(log) : cout;
+  const Graph& g = *m_graph;
+
+  if (m_cvoGraph) {
+    CMauiAVLTreeSimple cvoAvlVars2CheckScore;
+    ARE::AdjVarMemoryDynamicManager cvoTempAdjVarSpace(ARE_TempAdjVarSpaceSize);
+
+    m_cvoGraph->ComputeVariableEliminationOrder_Simple_wMinFillOnly(
+        INT_MAX, false, true, 10, -1, 0.0, cvoAvlVars2CheckScore, cvoTempAdjVarSpace);
+    m_cvoGraph->ReAllocateEdges();
+  }
+
   // Find variable ordering
   vector<int> elim;
   int w = numeric_limits<int>::max();
@@ -160,14 +202,27 @@ bool Main::findOrLoadOrdering() {
     orderFromFile = m_problem->parseOrdering(m_options->in_orderingFile, elim);
   }
 
+  bool orderFromCache = false;
+  if (m_orderCache) {
+    int wCache = NONE, hCache = NONE;
+    double cCache = 0.0;
+    if (!orderFromFile)
+      orderFromCache = m_orderCache->load(elim, wCache, hCache, cCache);
+  }
+
   // Init. pseudo tree
-  m_pseudotree.reset(new Pseudotree(m_problem.get(), m_options->subprobOrder));
+  m_orderTree.reset(new Pseudotree(m_problem.get(), m_options->subprobOrder));
 
   if (orderFromFile) { // Reading from file succeeded (i.e. file exists)
-    m_pseudotree->build(g, elim, m_options->cbound);
-    w = m_pseudotree->getWidth();
-    cout << "Read elimination ordering from file " << m_options->in_orderingFile
-         << " (" << w << '/' << m_pseudotree->getHeight() << ")." << endl;
+    m_orderTree->build(g, elim, m_options->cbound);
+    w = m_orderTree->getWidth();
+    out << "Read elimination ordering from file " << m_options->in_orderingFile
+        << " (" << w << '/' << m_orderTree->getHeight() << ")." << endl;
+  } else if (orderFromCache) {
+    m_orderTree->build(g, elim, m_options->cbound);
+    w = m_orderTree->getWidth();
+    out << "Read elimination ordering from cache " << m_orderCache->getFilename()
+        << " (" << w << '/' << m_orderTree->getHeight() << ")." << endl;
   } else {
     if (m_options->order_timelimit == NONE)
       // compute at least one
@@ -178,79 +233,55 @@ bool Main::findOrLoadOrdering() {
   double timediff = 0.0;
   time(&time_order_start);
 
+  int threads = 1;
+#ifndef NOTHREADS
+  threads = max(1, m_options->order_threads);
+#endif
+
   // Search for variable elimination ordering, looking for min. induced
   // width, breaking ties via pseudo tree height
-  cout << "Searching for elimination ordering,";
+  out << "Searching for elimination ordering,";
   if (m_options->order_cvo)
-    cout << " CVO,";
+    out << " CVO,";
+  if (m_options->order_objective != ORDER_OBJ_WIDTH)
+    out << " objective " << order_objective[m_options->order_objective] << ',';
   if (m_options->order_iterations != NONE)
-    cout << " " << m_options->order_iterations << " iterations";
+    out << " " << m_options->order_iterations << " iterations";
   if (m_options->order_timelimit != NONE)
-    cout << " " << m_options->order_timelimit << " seconds";
-  cout << ":" << flush;
-
-  int iterCount=0, sinceLast=0;
-  int remaining = m_options->order_iterations;
-
-  while (true) {
-
-    if (m_options->order_iterations != NONE && remaining == 0)
-      break;
-
-    vector<int> elimCand;  // new ordering candidate
-    bool improved = false;  // improved in this iteration?
-    int new_w;
-    if (m_options->order_cvo) {
-      *cvoGraph = *cvoMasterGraph;
-      new_w = cvoGraph->ComputeVariableEliminationOrder_Simple_wMinFillOnly(
-          w, true, false, 10, -1, 0.0, *cvoAvlVars2CheckScore, *cvoTempAdjVarSpace);
-      if (new_w != 0)
-        new_w = INT_MAX;
-      else {
-        new_w = cvoGraph->_VarElimOrderWidth;
-        elimCand.assign(cvoGraph->_VarElimOrder,
-                        cvoGraph->_VarElimOrder + cvoGraph->_nNodes);
-      }
-    } else {
-      new_w = m_pseudotree->eliminate(g,elimCand,w);
-    }
-    if (new_w < w) {
-      elim = elimCand; w = new_w; improved = true;
-      m_pseudotree->build(g, elimCand, m_options->cbound);
-      cout << " " << iterCount << ':' << w <<'/' << m_pseudotree->getHeight() << flush;
-    } else if (new_w == w) {
-      Pseudotree ptCand(m_problem.get(), m_options->subprobOrder);
-      ptCand.build(g, elimCand, m_options->cbound);
-      if (ptCand.getHeight() < m_pseudotree->getHeight()) {
-        elim = elimCand; improved = true;
-        m_pseudotree->build(g, elim, m_options->cbound);
-        cout << " " << iterCount << ':' << w << '/' << m_pseudotree->getHeight() << flush;
-      }
-    }
-    ++iterCount, ++sinceLast, --remaining;
-
-    // Adaptive ordering scheme
-    if (improved && m_options->autoIter && remaining > 0) {
-      remaining = max(remaining, sinceLast+1);
-      sinceLast = 0;
-    }
-
-    // check termination conditions
-    time(&time_order_cur);
-    timediff = difftime(time_order_cur, time_order_start);
-    if (m_options->order_timelimit != NONE && timediff > m_options->order_timelimit)
-      break;
+    out << " " << m_options->order_timelimit << " seconds";
+  if (threads > 1)
+    out << ", " << threads << " threads";
+  out << ":" << flush;
+
+  OrderingSearch orderSearch(m_problem.get(), m_options.get(), g, m_cvoGraph.get());
+  orderSearch.setQuiet(quiet);
+  if (orderFromFile || orderFromCache)
+    orderSearch.setOrdering(elim, w, m_orderTree->getHeight());
+  orderSearch.run(threads);
+
+  if (orderSearch.getOrdering() != elim) {
+    elim = orderSearch.getOrdering();
+    w = orderSearch.getWidth();
+    m_orderTree->build(g, elim, m_options->cbound);
   }
+
   time(&time_order_cur);
   timediff = difftime(time_order_cur, time_order_start);
-  cout << endl << "Ran " << iterCount << " iterations (" << int(timediff)
-       << " seconds), lowest width/height found: "
-       << w << '/' << m_pseudotree->getHeight() << '\n';
+  out << endl << "Ran " << orderSearch.getIterations() << " iterations (" << int(timediff)
+      << " seconds), lowest width/height found: "
+      << w << '/' << m_orderTree->getHeight();
+  if (m_options->order_objective != ORDER_OBJ_WIDTH)
+    out << ", " << order_objective[m_options->order_objective] << ": " << orderSearch.getCost();
+  out << '\n';
+
+  // Update ordering cache?
+  if (m_orderCache && m_orderCache->save(elim, w, m_orderTree->getHeight(), orderSearch.getCost()))
+    out << "Saved ordering to cache " << m_orderCache->getFilename() << endl;
 
   // Save order to file?
   if (!m_options->in_orderingFile.empty() && !orderFromFile) {
     m_problem->saveOrdering(m_options->in_orderingFile, elim);
-    cout << "Saved ordering to file " << m_options->in_orderingFile << endl;
+    out << "Saved ordering to file " << m_options->in_orderingFile << endl;
   }
 #if defined PARALLEL_DYNAMIC || defined PARALLEL_STATIC
 #if defined PARALLEL_STATIC
@@ -260,16 +291,29 @@ bool Main::findOrLoadOrdering() {
     m_options->in_orderingFile = string("temp_elim.") + m_options->problemName
         + string(".") + m_options->runTag + string(".gz");
     m_problem->saveOrdering(m_options->in_orderingFile,elim);
-    cout << "Saved ordering to file " << m_options->in_orderingFile << endl;
+    out << "Saved ordering to file " << m_options->in_orderingFile << endl;
   }
 #endif
 
   // OR search?
   if (m_options->orSearch) {
-    cout << "Rebuilding pseudo tree as chain." << endl;
-    m_pseudotree->buildChain(g, elim, m_options->cbound);
+    out << "Rebuilding pseudo tree as chain." << endl;
+    m_orderTree->buildChain(g, elim, m_options->cbound);
   }
 
+  m_orderLog = log.str();
+  return true;
+}
+
+
+bool Main::finishOrdering() {
+  cout << m_orderLog << flush;
+  m_orderLog.clear();
+  m_pseudotree.swap(m_orderTree);
+  m_orderTree.reset();
+  m_cvoGraph.reset();
+  m_graph.reset();
+
   // Pseudo tree has dummy node after build(), add to problem
   m_problem->addDummy(); // add dummy variable to problem, to be in sync with pseudo tree
   m_pseudotree->resetFunctionInfo(m_problem->getFunctions());
@@ -313,16 +357,39 @@ bool Main::runSLS() {
 #ifdef ENABLE_SLS
   if (!m_options->in_subproblemFile.empty())
     return true;  // no SLS in case of subproblem processing
+#if not (defined PARALLEL_DYNAMIC || defined PARALLEL_STATIC || defined NOTHREADS)
+  if (m_options->slsLive) {
+    // restarts until the search is done, overlapping with the remaining
+    // preprocessing already; solutions are exchanged in searchSubproblem()
+    oss ss;
+    ss << "Running SLS concurrently with search, "
+       << m_options->slsTime << " seconds per run" << endl;
+    myprint(ss.str());
+    m_slsWrapper.reset(new SLSWrapper());
+    m_slsWrapper->init(m_problem.get(), numeric_limits<int>::max(), m_options->slsTime,
+                       m_options->slsThreads);
+    m_slsWrapper->start();
+    return true;
+  }
+#endif
   if (m_options->slsIter <= 0)
     return true;
   oss ss;
   ss << "Running SLS " << m_options->slsIter << " times for "
-     << m_options->slsTime << " seconds" << endl;
+     << m_options->slsTime << " seconds";
+  if (m_options->slsThreads > 1)
+    ss << " in " << min(m_options->slsThreads, m_options->slsIter) << " threads";
+  ss << endl;
   myprint(ss.str());
   m_slsWrapper.reset(new SLSWrapper());
-  m_slsWrapper->init(m_problem.get(), m_options->slsIter, m_options->slsTime);
+  m_slsWrapper->init(m_problem.get(), m_options->slsIter, m_options->slsTime,
+                     m_options->slsThreads);
   m_slsWrapper->run();
-  myprint("SLS finished.\n");
+  double rate = 0.0;
+  long flips = m_slsWrapper->getFlipStats(rate);
+  oss ss2;
+  ss2 << "SLS finished, " << flips << " flips (" << (long) rate << " flips/sec)." << endl;
+  myprint(ss2.str());
 #endif
   return true;
 }
@@ -379,10 +446,32 @@ bool Main::initDataStructs() {
     }else {
       m_problem->setSubprobOnly();
       m_options->order_iterations = 0;
-      cout << "Reading subproblem from file " << m_options->in_subproblemFile << '.' << endl;
-      if (!m_search->restrictSubproblem(m_options->in_subproblemFile) ) {
-        err_txt("Subproblem restriction failed.");
-        return false;
+      const string& spec = m_options->in_subproblemFile;
+      size_t i = spec.rfind(':');
+      vector<int> ids;
+      if (i != string::npos) {
+        istringstream ss(spec.substr(i+1));
+        int id = NONE;
+        char sep;
+        while (ss >> id) {
+          ids.push_back(id);
+          ss >> sep;
+        }
+      }
+      if (ids.size() > 1) {
+        // batch of subproblems: heuristic is compiled for the full problem,
+        // each subproblem is restricted in turn when searching
+        m_batchFile = spec.substr(0, i);
+        m_batch = ids;
+        cout << "Solving batch of " << m_batch.size() << " subproblems from file "
+             << m_batchFile << '.' << endl;
+      } else {
+        m_subprobId = ids.empty() ? NONE : ids.front();
+        cout << "Reading subproblem from file " << spec << '.' << endl;
+        if (!m_search->restrictSubproblem(spec) ) {
+          err_txt("Subproblem restriction failed.");
+          return false;
+        }
       }
     }
   }
@@ -496,7 +585,9 @@ bool Main::compileHeuristic() {
   }
 
 #ifndef NO_HEURISTIC
-  if (m_search->getCurOptValue() >= m_heuristic->getGlobalUB()) {
+  if (!m_batch.empty()) {
+    // heuristic is for the full problem, every subproblem still needs search
+  } else if (m_search->getCurOptValue() >= m_heuristic->getGlobalUB()) {
     m_solved = true;
     cout << endl << "--------- Solved during preprocessing ---------" << endl;
   }
@@ -516,8 +607,14 @@ bool Main::runLDS() {
   if (m_options->par_postOnly)
     return true;  // skip LDS for static post mode
 #endif
+  if (!m_batch.empty())
+    return true;  // no LDS for batches of subproblems
   // Run LDS if specified
   if (m_options->lds != NONE) {
+#ifndef NOTHREADS
+    if (m_options->ldsThreads > 1 || m_options->ldsTime != NONE)
+      return runIterativeLDS();
+#endif
     cout << "Running LDS with limit " << m_options->lds << endl;
     scoped_ptr<SearchSpace> spaceLDS(new SearchSpace(m_pseudotree.get(), m_options.get()));
     LimitedDiscrepancy lds(m_problem.get(), m_pseudotree.get(), spaceLDS.get(),
@@ -560,6 +657,35 @@ bool Main::runLDS() {
 }
 
 
+#ifndef NOTHREADS
+bool Main::runIterativeLDS() {
+  int threads = max(1, min(m_options->ldsThreads, m_options->lds + 1));
+  cout << "Running LDS iteratively with limits 0.." << m_options->lds
+       << " in " << threads << " threads";
+  if (m_options->ldsTime != NONE)
+    cout << " for " << m_options->ldsTime << " seconds";
+  cout << endl;
+
+  IterativeLDS lds(m_problem.get(), m_pseudotree.get(), m_heuristic.get(), m_options.get());
+  lds.run(threads);
+  cout << "LDS: explored " << lds.getNumExpOR() << '/' << lds.getNumExpAND() << " OR/AND nodes, ";
+  if (lds.getCompleted())
+    cout << "completed limits 0.." << lds.getCompleted() - 1 << endl;
+  else
+    cout << "no limit completed" << endl;
+  cout << "LDS: solution cost " << lds.getCurOptValue() << endl;
+
+#ifndef NO_HEURISTIC
+  if (lds.getCurOptValue() >= m_heuristic->getGlobalUB()) {
+    m_solved = true;
+    cout << endl << "--------- Solved by LDS ---------" << endl;
+  }
+#endif
+  return true;
+}
+#endif
+
+
 bool Main::finishPreproc() {
 
   // load current best solution from preprocessing into search instance
@@ -605,21 +731,44 @@ bool Main::runSearchDynamic() {
     sigfillset( & new_signal_mask );
     pthread_sigmask(SIG_BLOCK, &new_signal_mask, NULL); // block all signals
 
+    if (!m_options->par_threaded) {
+      // Condor jobs poll this file for bound updates (needs shared file system)
+      oss boundFile;
+      boundFile << "temp_bound." << m_options->problemName << '.' << m_options->runTag;
+      m_space->boundFile = boundFile.str();
+      remove(m_space->boundFile.c_str());  // from previous run
+    }
+
     try {
     CondorSubmissionEngine cse(m_space.get());
 
     boost::thread thread_prop(boost::ref(prop));
     boost::thread thread_bab(boost::ref( *m_search ));
-    boost::thread thread_cse(boost::ref(cse));
+    // no Condor submission when solving subproblems in local threads
+    scoped_ptr<boost::thread> thread_cse;
+    if (!m_options->par_threaded)
+      thread_cse.reset(new boost::thread(boost::ref(cse)));
 
     // start signal handler
-    SigHandler sigH(&thread_bab, &thread_prop, &thread_cse);
+    SigHandler sigH(&thread_bab, &thread_prop, thread_cse.get());
     boost::thread thread_sh(boost::ref(sigH));
 
     thread_bab.join();
     thread_prop.join();
-    thread_cse.interrupt();
-    thread_cse.join();
+    if (thread_cse) {
+      thread_cse->interrupt();
+      thread_cse->join();
+    } else {
+      // interrupt local subproblem threads that are still running (if aborted)
+      GETLOCK(m_space->mtx_activeThreads, lk);
+      map<Subproblem*, boost::thread*>::iterator it = m_space->activeThreads.begin();
+      for (; it != m_space->activeThreads.end(); ++it) {
+        it->second->interrupt();
+        it->second->join();
+        delete it->second;
+      }
+      m_space->activeThreads.clear();
+    }
     cout << endl;
     } catch (...) {
       myerror("Caught signal during master execution, aborting.\n");
@@ -670,8 +819,13 @@ bool Main::runSearchStatic() {
     success = success && m_search->extSolveLocal();
   }
   if (!local && !preOnly && !postOnly) {
-    /* run Condor and wait for results */
-    success = success && m_search->runCondor();
+    if (m_options->par_poolSize != NONE) {
+      /* run local worker processes and collect results */
+      success = success && m_search->runLocalPool();
+    } else {
+      /* run Condor and wait for results */
+      success = success && m_search->runCondor();
+    }
   }
   if (!local && !preOnly) {
     /* read external results */
@@ -691,18 +845,261 @@ bool Main::runSearchStatic() {
 
 /* sequential mode or worker mode for distributed execution */
 bool Main::runSearchWorker() {
+  // channel for lower bound updates from the master, if any
+  scoped_ptr<BoundChannel> boundUpdates;
+  if (!m_options->in_boundUpdates.empty()) {
+    boundUpdates.reset(new BoundChannel);
+    if (!boundUpdates->open(m_options->in_boundUpdates)) {
+      cerr << "Error opening bound update channel " << m_options->in_boundUpdates << endl;
+      boundUpdates.reset();
+    }
+  }
+  size_t updates = 0;
+  double bound = ELEM_NAN;  // latest bound received from the master
+
+#if not (defined PARALLEL_DYNAMIC || defined PARALLEL_STATIC || defined NOTHREADS)
+  if (!m_options->portfolio.empty()) {
+    bool success = searchPortfolio();
+#ifdef ENABLE_SLS
+    if (m_slsWrapper)
+      m_slsWrapper->stop();
+#endif
+    m_solved = success;
+    return success;
+  }
+  if (m_options->compThreads > 1 && m_options->in_subproblemFile.empty()
+      && m_pseudotree->getComponentsCond() > 1) {
+    bool success = searchComponents();
+#ifdef ENABLE_SLS
+    if (m_slsWrapper)
+      m_slsWrapper->stop();
+#endif
+    m_solved = success;
+    return success;
+  }
+#endif
+
+  if (m_batch.empty())
+    searchSubproblem(boundUpdates.get(), bound, updates);
+  else if (!searchBatch(boundUpdates.get(), bound, updates))
+    return false;
+
+#if defined ENABLE_SLS && !defined NOTHREADS
+  if (m_slsWrapper)
+    m_slsWrapper->stop();  // concurrent SLS (--slsLive)
+#endif
+
+  if (boundUpdates) {
+    cout << "Bound updates:\t" << updates << " received, "
+         << m_space->stats.numPrunedBound << " nodes pruned due to them" << endl;
+  }
+
+  m_solved = true;
+  return true;
+}
+
+
+void Main::searchSubproblem(BoundChannel* boundUpdates, double& bound, size_t& updates) {
+  // time / node budget for subproblems, the master re-splits them once exceeded
+  bool budget = !m_options->in_subproblemFile.empty()
+      && (m_options->split_time != NONE || m_options->split_nodes != NONE);
+  time_t timeStart;
+  time(&timeStart);
+  m_splitOpen.clear();
+
+  double slsBound = ELEM_NAN;  // last solution handed to concurrent SLS
   BoundPropagator prop(m_problem.get(), m_space.get(), !m_options->nocaching);
   SearchNode* n = m_search->nextLeaf();
-  while (n) {
+  for (count_t leaves = 0; n; ++leaves) {
     prop.propagate(n, true); // true = report solutions
     n = m_search->nextLeaf();
+    if (!n || leaves % BOUND_POLL_INTERVAL != 0)
+      continue;
+    if (boundUpdates && boundUpdates->poll(bound) && m_search->updateGlobalBound(bound))
+      ++updates;
+#if defined ENABLE_SLS && !defined NOTHREADS
+    if (m_slsWrapper)
+      exchangeSLS(slsBound);
+#endif
+    if (budget && splitBudgetExceeded(timeStart)) {
+      m_search->getOpenRootValues(m_splitOpen);
+      break;
+    }
   }
 
-  m_solved = true;
+  if (!m_splitOpen.empty()) {
+    cout << "Subproblem budget exceeded, stopped with "
+         << count(m_splitOpen.begin(), m_splitOpen.end(), true)
+         << " open root values" << endl;
+  }
+}
+
+
+#if not (defined PARALLEL_DYNAMIC || defined PARALLEL_STATIC || defined NOTHREADS)
+bool Main::searchPortfolio() {
+  vector<PortfolioConfig> configs;
+  if (!Portfolio::parse(m_options->portfolio, configs)) {
+    err_txt("Invalid search portfolio " + m_options->portfolio + '.');
+    return false;
+  }
+  if (!m_options->in_subproblemFile.empty()) {
+    err_txt("Search portfolio not supported for subproblems.");
+    return false;
+  }
+
+  m_portfolio.reset(new Portfolio(m_problem.get(), m_pseudotree.get(),
+                                  m_heuristic.get(), m_options.get()));
+  m_portfolio->init(configs);
+  m_portfolio->run();
+
+  // report the search that proved optimality
+  m_search.reset(m_portfolio->releaseSearch());
+  m_space.reset(m_portfolio->releaseSpace());
+  return true;
+}
+#endif
+
+
+#if not (defined PARALLEL_DYNAMIC || defined PARALLEL_STATIC || defined NOTHREADS)
+bool Main::searchComponents() {
+  ComponentSearch comps(m_problem.get(), m_pseudotree.get(), m_heuristic.get(),
+                        m_options.get());
+  int threads = min(m_options->compThreads, (int) comps.getComponentCount());
+  cout << "Solving " << comps.getComponentCount() << " independent components in "
+       << threads << " threads" << endl;
+  comps.run(threads);
+
+  // combine stats and profiles of the component searches
+  SearchStats& stats = m_space->stats;
+  BOOST_FOREACH( const ComponentJob& job, comps.getJobs() ) {
+    stats.numExpOR += job.stats.numExpOR;
+    stats.numExpAND += job.stats.numExpAND;
+    stats.numProcOR += job.stats.numProcOR;
+    stats.numProcAND += job.stats.numProcAND;
+    stats.numLeaf += job.stats.numLeaf;
+    stats.numPruned += job.stats.numPruned;
+    stats.numDead += job.stats.numDead;
+    m_search->addProfiles(job.nodeP, job.leafP, job.depth);
+    cout << "Component at variable " << job.root << " (" << job.size << " variables): "
+         << SCALE_LOG(job.value) << ", " << job.stats.numExpOR << '/'
+         << job.stats.numExpAND << " OR/AND nodes" << endl;
+  }
+
+  double cost = comps.getSolutionCost();
+  double cur = m_problem->getSolutionCost();
+  if (!ISNAN(cost) && (ISNAN(cur) || cost > cur)) {
+#ifndef NO_ASSIGNMENT
+    vector<val_t> tuple;
+    comps.getSolution(tuple);
+    m_problem->updateSolution(cost, tuple, &stats, true);
+#else
+    m_problem->updateSolution(cost, &stats, true);
+#endif
+  }
+  return true;
+}
+#endif
+
+
+#if defined ENABLE_SLS && !defined NOTHREADS
+void Main::exchangeSLS(double& slsBound) {
+  double cost;
+  vector<val_t> tuple;
+  if (m_slsWrapper->poll(m_problem->getSolutionCost(), cost, tuple)) {
+#ifndef NO_ASSIGNMENT
+    m_problem->updateSolution(cost, tuple, NULL, true);
+#else
+    m_problem->updateSolution(cost, NULL, true);
+#endif
+    m_search->updateSolution(m_problem->getSolutionCost()
+#ifndef NO_ASSIGNMENT
+        , m_problem->getSolutionAssg()
+#endif
+    );
+  }
+#ifndef NO_ASSIGNMENT
+  // next SLS run starts from the current best solution
+  double d = m_problem->getSolutionCost();
+  if (!ISNAN(d) && (ISNAN(slsBound) || d > slsBound)) {
+    slsBound = d;
+    m_slsWrapper->restartFrom(m_problem->getSolutionAssg());
+  }
+#endif
+}
+#endif
+
+
+bool Main::searchBatch(BoundChannel* boundUpdates, double& bound, size_t& updates) {
+  // solutions go into one file, one after another, unless the file name
+  // has a placeholder for the subproblem id
+  const string& file = m_options->out_solutionFile;
+  bool perId = file.find("%ID%") != string::npos;
+  ogzstream out;
+  if (!file.empty() && !perId) {
+    out.open(file.c_str(), ios::out | ios::trunc | ios::binary);
+    if (!out) {
+      cerr << "Error writing optimal solution to file " << file << endl;
+      return false;
+    }
+  }
+
+  for (vector<int>::const_iterator it = m_batch.begin(); it != m_batch.end(); ++it) {
+    ostringstream spec;
+    spec << m_batchFile << ':' << *it;
+    m_problem->resetSolution();
+    if (!m_search->restrictSubproblem(spec.str())) {
+      err_txt("Subproblem restriction failed.");
+      return false;
+    }
+    // cached values might depend on the previous subproblem's context
+    if (m_space->cache) {
+      for (int i = 0; i < m_problem->getN(); ++i)
+        m_space->cache->reset(i);
+    }
+    m_search->finalizeHeuristic();
+    if (!ISNAN(bound))
+      m_search->updateGlobalBound(bound);
+
+    searchSubproblem(boundUpdates, bound, updates);
+    cout << "Subproblem " << *it << ": " << m_space->stats.numExpOR << " / "
+         << m_space->stats.numExpAND << " OR/AND nodes" << endl;
+
+    if (!m_options->out_resultLog.empty()) {
+      m_problem->appendResult(m_options->out_resultLog, *it, & m_space->stats,
+          m_search->getNodeProfile(), m_search->getLeafProfile(), &m_splitOpen);
+    }
+    if (perId) {
+      ostringstream id;
+      id << *it;
+      string name = file;
+      m_problem->outputAndSaveSolution(str_replace(name, "%ID%", id.str()), & m_space->stats,
+          m_search->getNodeProfile(), m_search->getLeafProfile(), true, &m_splitOpen);
+    } else {
+      m_problem->outputAndSaveSolution(file.empty() ? NULL : &out, & m_space->stats,
+          m_search->getNodeProfile(), m_search->getLeafProfile(), true, &m_splitOpen);
+    }
+  }
+
+  if (!file.empty() && !perId)
+    out.close();
   return true;
 }
 
 
+bool Main::splitBudgetExceeded(time_t timeStart) const {
+  if (m_options->split_nodes != NONE && m_space->stats.numExpOR + m_space->stats.numExpAND
+      > (count_t) m_options->split_nodes * 100000)
+    return true;
+  if (m_options->split_time != NONE) {
+    time_t now;
+    time(&now);
+    if (difftime(now, timeStart) >= m_options->split_time)
+      return true;
+  }
+  return false;
+}
+
+
 bool Main::outputStats() const {
   if (m_options->nosearch) {
      cout << "Found '--nosearch', full search skipped, exiting." << endl;
@@ -769,8 +1166,14 @@ bool Main::outputStats() const {
   cout << endl;
 
 //  pair<size_t,size_t> noNodes = make_pair(m_space->nodesOR, m_space->nodesAND);
-  m_problem->outputAndSaveSolution(m_options->out_solutionFile, & m_space->stats,
-      m_search->getNodeProfile(), m_search->getLeafProfile());
+  if (m_batch.empty()) {  // batches write their solutions as they go
+    m_problem->outputAndSaveSolution(m_options->out_solutionFile, & m_space->stats,
+        m_search->getNodeProfile(), m_search->getLeafProfile(), true, &m_splitOpen);
+    if (!m_options->out_resultLog.empty() && !m_options->in_subproblemFile.empty()) {
+      m_problem->appendResult(m_options->out_resultLog, m_subprobId, & m_space->stats,
+          m_search->getNodeProfile(), m_search->getLeafProfile(), &m_splitOpen);
+    }
+  }
 #ifdef PARALLEL_STATIC
   }
 #endif
@@ -0,0 +1,122 @@
+/*
+ * OrderingCache.cpp
+ *
+ *  Copyright (C) 2008-2012 Lars Otten
+ *  This file is part of DAOOPT.
+ *
+ *  DAOOPT is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  DAOOPT is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with DAOOPT.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Lars Otten <lotten@ics.uci.edu>
+ */
+
+#include "OrderingCache.h"
+
+#include <cstdio>
+#include <iomanip>
+#if defined(WINDOWS)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace daoopt {
+
+OrderingCache::OrderingCache(const string& dir, const Problem* p, int objective) :
+    m_problem(p), m_objective(objective) {
+  assert(p);
+  oss ss;
+  ss << dir;
+  if (!dir.empty() && dir[dir.size()-1] != '/')
+    ss << '/';
+  ss << hex << setfill('0') << setw(16) << p->getFingerprint();
+  if (objective != ORDER_OBJ_WIDTH)
+    ss << '.' << order_objective[objective];
+  ss << ".elim";
+  m_filename = ss.str();
+}
+
+
+bool OrderingCache::load(vector<int>& elim, int& width, int& height, double& cost) const {
+  ifstream in(m_filename.c_str());
+  if (in.fail())  // no entry yet
+    return false;
+
+  // ignore comment line
+  if (in.peek() == '#')
+    in.ignore(8192, '\n');
+
+  int w = NONE, h = NONE, n = NONE;
+  double c = 0.0;
+  in >> w >> h >> c >> n;
+  if (in.fail() || n != m_problem->getN()) {
+    cerr << "Ignoring invalid ordering cache entry " << m_filename << endl;
+    return false;
+  }
+
+  vector<int> buffer(n, NONE);
+  vector<bool> check(n, false);
+  for (int i = 0; i < n; ++i) {
+    in >> buffer[i];
+    if (in.fail() || buffer[i] < 0 || buffer[i] >= n || check[buffer[i]]) {
+      cerr << "Ignoring invalid ordering cache entry " << m_filename << endl;
+      return false;
+    }
+    check[buffer[i]] = true;
+  }
+
+  elim.swap(buffer);
+  width = w;
+  height = h;
+  cost = c;
+  return true;
+}
+
+
+bool OrderingCache::save(const vector<int>& elim, int width, int height, double cost) const {
+  assert((int) elim.size() == m_problem->getN());
+
+  // only replace an existing entry with a better ordering
+  vector<int> elimOld;
+  int wOld = NONE, hOld = NONE;
+  double cOld = 0.0;
+  if (load(elimOld, wOld, hOld, cOld) && (cOld < cost ||
+      (cOld == cost && (wOld < width || (wOld == width && hOld <= height)))))
+    return false;
+
+  // Write to temporary file first, then move into place, so concurrent
+  // runs never see a partial entry.
+  oss tempname;
+  tempname << m_filename << "-temp" << getpid();
+  ofstream out(tempname.str().c_str(), ios::out | ios::trunc);
+  if (!out) {
+    cerr << "Error writing ordering cache entry " << tempname.str() << endl;
+    return false;
+  }
+  out << "# daoopt ordering cache for " << m_problem->getName() << endl
+      << width << ' ' << height << ' ' << setprecision(17) << cost << endl << elim.size();
+  for (vector<int>::const_iterator it = elim.begin(); it != elim.end(); ++it)
+    out << ' ' << *it;
+  out << endl;
+  out.close();
+
+  if (out.fail() || rename(tempname.str().c_str(), m_filename.c_str())) {
+    cerr << "Error writing ordering cache entry " << m_filename << endl;
+    remove(tempname.str().c_str());
+    return false;
+  }
+  return true;
+}
+
+}  // namespace daoopt
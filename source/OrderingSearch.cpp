@@ -0,0 +1,179 @@
+/*
+ * OrderingSearch.cpp
+ *
+ *  Copyright (C) 2008-2012 Lars Otten
+ *  This file is part of DAOOPT.
+ *
+ *  DAOOPT is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  DAOOPT is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with DAOOPT.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Lars Otten <lotten@ics.uci.edu>
+ */
+
+#include "OrderingSearch.h"
+
+#include "cvo/ARPall.hxx"
+
+namespace daoopt {
+
+/* CVO graph that allows reseeding its internal random number generator */
+class CvoGraph : public ARE::Graph {
+public:
+  void seed(unsigned long s) { _RNG.seed(s); }
+};
+
+
+void OrderingSearch::setOrdering(const vector<int>& elim, int width, int height) {
+  m_elim = elim;
+  m_width = width;
+  m_height = height;
+  m_cost = 0.0;
+  if (m_options->order_objective != ORDER_OBJ_WIDTH) {
+    EliminationGraph eg(m_graph);
+    eg.setObjective(m_options->order_objective, m_problem->getDomains(), m_options->cbound);
+    eg.evaluate(elim);
+    m_cost = eg.getCost();
+  }
+}
+
+
+void OrderingSearch::run(int threads) {
+  time(&m_timeStart);
+#ifndef NOTHREADS
+  if (threads > 1) {
+    boost::thread_group group;
+    for (int i = 0; i < threads; ++i)
+      group.create_thread(OrderingThread(this, rand::next()));
+    group.join_all();
+    return;
+  }
+#endif
+  // single thread, use global random number generator
+  this->work(NULL);
+}
+
+
+void OrderingSearch::work(RandStream* rs) {
+  // compact copy of the primal graph, reused for every min-fill iteration
+  // (also used to evaluate the objective of CVO orderings)
+  scoped_ptr<EliminationGraph> elimGraph;
+  if (!m_options->order_cvo || m_options->order_objective != ORDER_OBJ_WIDTH) {
+    elimGraph.reset(new EliminationGraph(m_graph));
+    elimGraph->setObjective(m_options->order_objective, m_problem->getDomains(),
+                            m_options->cbound);
+  }
+
+  scoped_ptr<CvoGraph> cvoGraph;
+  scoped_ptr<CMauiAVLTreeSimple> cvoAvlVars2CheckScore;
+  scoped_ptr<ARE::AdjVarMemoryDynamicManager> cvoTempAdjVarSpace;
+  if (m_options->order_cvo) {
+    assert(m_cvoMaster);
+    cvoGraph.reset(new CvoGraph);
+    if (rs)
+      cvoGraph->seed(rs->next());
+    cvoAvlVars2CheckScore.reset(new CMauiAVLTreeSimple);
+    cvoTempAdjVarSpace.reset(new ARE::AdjVarMemoryDynamicManager(ARE_TempAdjVarSpaceSize));
+  }
+
+  vector<int> elimCand;  // new ordering candidate
+  int iter = NONE, limit = NONE;
+  double costLimit = 0.0;
+  while ( (iter = nextIteration(limit, costLimit)) != NONE ) {
+    int new_w;
+    double cost = 0.0;
+    if (m_options->order_cvo) {
+      cvoGraph->ARE::Graph::operator=(*m_cvoMaster);
+      new_w = cvoGraph->ComputeVariableEliminationOrder_Simple_wMinFillOnly(
+          limit, true, false, 10, -1, 0.0, *cvoAvlVars2CheckScore, *cvoTempAdjVarSpace);
+      if (new_w != 0)
+        new_w = INT_MAX;
+      else {
+        new_w = cvoGraph->_VarElimOrderWidth;
+        elimCand.assign(cvoGraph->_VarElimOrder,
+                        cvoGraph->_VarElimOrder + cvoGraph->_nNodes);
+        if (elimGraph) {
+          elimGraph->evaluate(elimCand);
+          cost = elimGraph->getCost();
+        }
+      }
+    } else {
+      new_w = elimGraph->eliminate(elimCand, limit, rs, costLimit);
+      cost = elimGraph->getCost();
+    }
+
+    if (new_w > limit || cost > costLimit)
+      continue;  // worse than best ordering, or terminated early
+
+    // build candidate pseudo tree to break ties via height
+    Pseudotree ptCand(m_problem, m_options->subprobOrder);
+    ptCand.build(m_graph, elimCand, m_options->cbound);
+    reportOrdering(iter, elimCand, new_w, ptCand.getHeight(), cost);
+  }
+}
+
+
+int OrderingSearch::nextIteration(int& limit, double& costLimit) {
+#ifndef NOTHREADS
+  boost::mutex::scoped_lock lock(m_mtx);
+#endif
+  if (m_options->order_iterations != NONE && m_remaining == 0)
+    return NONE;
+
+  if (m_iterCount > 0 && m_options->order_timelimit != NONE) {
+    time_t now;
+    time(&now);
+    if (difftime(now, m_timeStart) > m_options->order_timelimit)
+      return NONE;
+  }
+
+  ++m_sinceLast, --m_remaining;
+  if (m_options->order_objective == ORDER_OBJ_WIDTH) {
+    limit = m_width;
+    costLimit = numeric_limits<double>::infinity();
+  } else {
+    limit = INT_MAX;
+    costLimit = m_cost;
+  }
+  return m_iterCount++;
+}
+
+
+bool OrderingSearch::reportOrdering(int iter, const vector<int>& elim, int width, int height,
+                                    double cost) {
+#ifndef NOTHREADS
+  boost::mutex::scoped_lock lock(m_mtx);
+#endif
+  if (!isBetter(width, height, cost))
+    return false;
+
+  m_elim = elim;
+  m_width = width;
+  m_height = height;
+  m_cost = cost;
+  if (!m_quiet) {
+    cout << " " << iter << ':' << width << '/' << height;
+    if (m_options->order_objective != ORDER_OBJ_WIDTH)
+      cout << '/' << cost;
+    cout << flush;
+  }
+
+  // Adaptive ordering scheme
+  if (m_options->autoIter && m_remaining > 0) {
+    m_remaining = max(m_remaining, m_sinceLast+1);
+    m_sinceLast = 0;
+  }
+  return true;
+}
+
+}  // namespace daoopt
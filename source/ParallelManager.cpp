@@ -27,6 +27,17 @@
 
 #ifdef PARALLEL_STATIC
 
+#include "gzstream.h"
+#include "BoundChannel.h"
+
+#if !defined(WINDOWS)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 namespace daoopt {
 
 /* parameters that can be modified */
@@ -45,11 +56,16 @@ namespace daoopt {
 #define PREFIX_STATS "temp_stats."
 #define PREFIX_SAMPLE "temp_sample."
 #define PREFIX_LOWERBOUND "temp_lb."
+#define PREFIX_MODEL "temp_model."
 
 #define PREFIX_JOBS "temp_jobs."
 
 #define TEMPLATE_FILE "daoopt-template.condor"
 
+/* file descriptors for solution data and bound updates of local pool workers */
+#define WORKER_SOLUTION_FD 3
+#define WORKER_BOUND_FD 4
+
 /* custom attributes for generated condor jobs */
 #define CONDOR_ATTR_PROBLEM "daoopt_problem"
 #define CONDOR_ATTR_THREADID "daoopt_threadid"
@@ -81,6 +97,15 @@ struct PQEntryComp {
 };
 
 
+/* subproblem ids of a worker job, separated by commas */
+string joinIds(const vector<size_t>& ids) {
+  ostringstream ss;
+  for (vector<size_t>::const_iterator it = ids.begin(); it != ids.end(); ++it)
+    ss << (it == ids.begin() ? "" : ",") << *it;
+  return ss.str();
+}
+
+
 bool ParallelManager::storeLowerBound() const {
   oss fname;
   fname << PREFIX_LOWERBOUND << m_options->problemName << "." << m_options->runTag
@@ -103,17 +128,17 @@ bool ParallelManager::loadLowerBound() {
 
 
 bool ParallelManager::doLearning() {
+  if (!m_options->in_learnModel.empty()) {
+    if (!m_learner->modelFromFile(m_options->in_learnModel)) {
+      myerror("Error reading complexity model from " + m_options->in_learnModel + "\n");
+      return false;
+    }
+    myprint("Read complexity model from " + m_options->in_learnModel + "\n");
+  }
+
   if (m_options->sampleRepeat == 0 || m_options->sampleSizes.empty())
     return true;
 
-#ifndef NO_ASSIGNMENT
-  m_sampleSearch->updateSolution(this->getCurOptValue(), this->getCurOptTuple());
-#else
-  m_sampleSearch->updateSolution(this->getCurOptValue());
-#endif
-
-  BoundPropagator prop(m_problem, m_sampleSpace.get());
-
   vector<double> sampleSizes;
   for (int i = 0; i < m_options->sampleRepeat; ++i) {
     istringstream iss(m_options->sampleSizes);
@@ -128,8 +153,19 @@ bool ParallelManager::doLearning() {
   // collect samples
   size_t sampleCount = 0;
   for (; sampleCount < sampleSizes.size(); ++sampleCount) {
-    m_sampleSearch->reset();
-    prop.resetSubCount();
+    // fresh search space for every sample (previous one is partially explored)
+    m_sampleSpace.reset(new SearchSpace(m_pseudotree, m_options));
+    m_sampleSearch.reset(new BranchAndBoundSampler(m_problem, m_pseudotree,
+                                                   m_sampleSpace.get(), m_heuristic));
+#ifndef NO_HEURISTIC
+    m_sampleSearch->finalizeHeuristic();
+#endif
+#ifndef NO_ASSIGNMENT
+    m_sampleSearch->updateSolution(this->getCurOptValue(), this->getCurOptTuple());
+#else
+    m_sampleSearch->updateSolution(this->getCurOptValue());
+#endif
+    BoundPropagator prop(m_problem, m_sampleSpace.get());
 
     SearchNode* n = NULL;
     do  {
@@ -141,9 +177,10 @@ bool ParallelManager::doLearning() {
     if (n) {
       cout << prop.getSubproblemStatsCache() << endl;
       m_learner->addSample(prop.getSubproblemStatsCache());
-    } else {  // problem solved
-      assert(false);  // TODO !
-      break;
+    } else {  // problem solved before reaching sample size
+      oss ss;
+      ss << "Sampling solved the full problem, no sample of size " << sampleSizes[sampleCount] << endl;
+      myprint(ss.str());
     }
   }
 
@@ -152,6 +189,21 @@ bool ParallelManager::doLearning() {
   fname << PREFIX_SAMPLE << m_options->problemName << '.' << m_options->runTag << ".csv";
   m_learner->statsToFile(fname.str());
 
+  // Train model (replaces a model read from file)
+  if (!m_learner->trainModel()) {
+    oss ss;
+    ss << "Complexity model not trained from " << m_learner->getSampleCount() << " samples";
+    if (m_learner->isTrained())
+      ss << ", keeping model from " << m_options->in_learnModel;
+    ss << endl;
+    myprint(ss.str());
+    return true;
+  }
+  myprint(m_learner->errorReport());
+  string modelFile = filename(PREFIX_MODEL, ".txt");
+  if (m_learner->modelToFile(modelFile))
+    myprint("Saved complexity model to " + modelFile + "\n");
+
   return true;
 }
 
@@ -224,16 +276,24 @@ bool ParallelManager::restoreFrontier() {
 
   ptnode = m_pseudotree->getNode(node->getVar());
 
-#ifndef NO_HEURISTIC
-  // precompute heuristic of initial dummy OR node (couldn't be done earlier)
-  assignCostsOR(node);
-#endif
-
   stack<SearchNode*> dfs;
-  dfs.push(node);
 
   // intermediate vector for expanding nodes into
   vector<SearchNode*> newNodes;
+
+  if (node->getType() == NODE_AND) {
+    // dummy AND node below root (from finalizeHeuristic()), expand first
+    expandStartAND(node, newNodes);
+    for (vector<SearchNode*>::iterator it=newNodes.begin(); it!=newNodes.end(); ++it)
+      dfs.push(*it);
+    newNodes.clear();
+  } else {
+#ifndef NO_HEURISTIC
+    // precompute heuristic of initial dummy OR node (couldn't be done earlier)
+    assignCostsOR(node);
+#endif
+    dfs.push(node);
+  }
   count = 0;
 
   // prepare m_external vector for frontier nodes
@@ -293,16 +353,27 @@ bool ParallelManager::findFrontier() {
   // queue of subproblems, i.e. OR nodes, ordered according to
   // evaluation function
   priority_queue<PQEntry, vector<PQEntry>, PQEntryComp> m_open;
-  m_open.push(make_pair(eval,node));
-
-#ifndef NO_HEURISTIC
-  // precompute heuristic of initial dummy OR node (couldn't be done earlier)
-  assignCostsOR(node);
-#endif
 
   // intermediate container for expanding nodes into
   vector<SearchNode*> newNodes;
 
+  if (node->getType() == NODE_AND) {
+    // dummy AND node below root (from finalizeHeuristic()), expand first
+    if (expandStartAND(node, newNodes))
+      return true;  // no subproblems
+    for (vector<SearchNode*>::iterator it=newNodes.begin(); it!=newNodes.end(); ++it) {
+      (*it)->setInitialBound(lowerBound(*it));
+      m_open.push(make_pair(evaluate(*it),*it) );
+    }
+    newNodes.clear();
+  } else {
+    m_open.push(make_pair(eval,node));
+#ifndef NO_HEURISTIC
+    // precompute heuristic of initial dummy OR node (couldn't be done earlier)
+    assignCostsOR(node);
+#endif
+  }
+
   // split subproblems
   while (m_open.size()
       && (m_options->threads == NONE
@@ -428,6 +499,7 @@ bool ParallelManager::extSolveLocal() {
     m_prop.propagate(m_external[i], true, m_external[i]);
   }
 
+  reportPredictionError(nodecounts);
   myprint("Writing CSV stats.\n");
   writeStatsCSV(m_external, &nodecounts);
 
@@ -489,6 +561,10 @@ bool ParallelManager::writeJobs() const {
   }
   templ.close();
 
+  // records from a previous run would be mistaken for results
+  if (!m_options->out_resultLog.empty())
+    remove(m_options->out_resultLog.c_str());
+
   // encode actual subproblems
   string alljobs = encodeJobs(m_external);
   jobstr << alljobs;
@@ -566,17 +642,348 @@ bool ParallelManager::waitForGrid() const {
 }
 
 
+#if !defined(WINDOWS)
+/* a running local worker process */
+struct LocalWorker {
+  pid_t pid;      // process id
+  size_t job;     // index of worker job
+  int boundFd;    // write end of bound update pipe
+};
+#endif
+
+
+bool ParallelManager::runLocalPool() {
+#if defined(WINDOWS)
+  myerror("Local worker pool not supported on this platform.\n");
+  return false;
+#else
+  int poolSize = max(1, m_options->par_poolSize);
+  m_extParsed.clear();
+  m_extParsed.resize(m_subprobCount, false);
+  m_extCounts.clear();
+  m_extCounts.resize(m_subprobCount);
+
+  // worker jobs and their queue, by estimate of the largest subproblem in
+  // each job, largest first (taken from the back)
+  vector<vector<size_t> > batches;
+  packJobs(batches);
+  vector<pair<double, size_t> > jobs;
+  jobs.reserve(batches.size());
+  for (size_t j = 0; j < batches.size(); ++j)
+    jobs.push_back(make_pair(m_external.at(batches[j].front())->getComplexityEstimate(), j));
+  sort(jobs.begin(), jobs.end());
+
+  {
+    ostringstream ss;
+    ss << "Solving " << m_subprobCount << " subproblems in " << batches.size()
+       << " jobs with " << poolSize << " local workers ("
+       << m_options->workerExecutable << ")" << endl;
+    myprint(ss.str());
+  }
+
+  // workers that exit early would otherwise kill us through their bound pipe
+  signal(SIGPIPE, SIG_IGN);
+  // global lower bound known to the workers (from the subproblem PSTs)
+  double bound = getCurOptValue();
+  size_t broadcasts = 0;
+  size_t resplits = 0;
+
+  // running workers and the readers for their results, indexed by read
+  // end of their solution pipe
+  map<int, LocalWorker> running;
+  map<int, ResultReader> readers;
+  vector<pollfd> pfds;
+  char buf[4096];
+  size_t done = 0;
+
+  while (!jobs.empty() || !running.empty()) {
+
+    // fill up the pool
+    while (!jobs.empty() && (int) running.size() < poolSize) {
+      size_t job = jobs.back().second;
+      jobs.pop_back();
+
+      vector<string> args;
+      workerArguments(batches[job], args);
+      vector<char*> argv;
+      for (vector<string>::iterator it = args.begin(); it != args.end(); ++it)
+        argv.push_back(const_cast<char*>(it->c_str()));
+      argv.push_back(NULL);
+
+      int fds[2], bfds[2];
+      if (pipe(fds)) {
+        myerror("Error creating pipe for local worker.\n");
+        return false;
+      }
+      if (pipe(bfds)) {
+        close(fds[0]);
+        close(fds[1]);
+        myerror("Error creating pipe for local worker.\n");
+        return false;
+      }
+      fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+      fcntl(bfds[1], F_SETFD, FD_CLOEXEC);
+
+      pid_t pid = fork();
+      if (pid == 0) {
+        // worker process: solution goes into pipe, bound updates come from
+        // the other one, screen output is discarded
+        int sol = fcntl(fds[1], F_DUPFD, 10);
+        int bnd = fcntl(bfds[0], F_DUPFD, 10);
+        dup2(sol, WORKER_SOLUTION_FD);
+        dup2(bnd, WORKER_BOUND_FD);
+        close(sol);
+        close(bnd);
+        if (fds[1] != WORKER_SOLUTION_FD && fds[1] != WORKER_BOUND_FD)
+          close(fds[1]);
+        if (bfds[0] != WORKER_SOLUTION_FD && bfds[0] != WORKER_BOUND_FD)
+          close(bfds[0]);
+        int devnull = open("/dev/null", O_WRONLY);
+        if (devnull >= 0) {
+          dup2(devnull, STDOUT_FILENO);
+          close(devnull);
+        }
+        execvp(argv[0], &argv[0]);
+        _exit(127);
+      }
+      close(fds[1]);
+      close(bfds[0]);
+      if (pid < 0) {
+        close(fds[0]);
+        close(bfds[1]);
+        myerror("Error starting local worker process.\n");
+        return false;
+      }
+      fcntl(bfds[1], F_SETFL, O_NONBLOCK);
+      LocalWorker worker = { pid, job, bfds[1] };
+      running.insert(make_pair(fds[0], worker));
+      readers[fds[0]] = ResultReader();
+      // bound might have improved since the subproblem was generated
+      if (broadcasts)
+        BoundChannel::writePipe(worker.boundFd, bound);
+    }
+
+    // wait for solution data from any of the workers
+    pfds.clear();
+    for (map<int, LocalWorker>::iterator it = running.begin(); it != running.end(); ++it) {
+      pollfd p = { it->first, POLLIN, 0 };
+      pfds.push_back(p);
+    }
+    if (poll(&pfds[0], pfds.size(), -1) < 0) {
+      if (errno == EINTR)
+        continue;
+      myerror("Error waiting for local workers.\n");
+      return false;
+    }
+
+    for (vector<pollfd>::iterator it = pfds.begin(); it != pfds.end(); ++it) {
+      if (!it->revents)
+        continue;
+      LocalWorker worker = running[it->fd];
+      vector<size_t> ids = batches[worker.job];  // copy, batches might grow
+      ssize_t r = read(it->fd, buf, sizeof(buf));
+      if (r < 0 && errno == EINTR)
+        continue;
+
+      if (r > 0) {
+        // parse and propagate results as they arrive, to learn about better solutions
+        ResultReader& reader = readers[it->fd];
+        reader.feed(buf, r);
+        SubproblemResult res;
+        while (reader.next(res)) {
+          if (res.id < 0 || find(ids.begin(), ids.end(), (size_t) res.id) == ids.end()
+              || m_extParsed.at(res.id)) {
+            ostringstream ss;
+            ss << "Ignoring unexpected result for subproblem " << res.id << endl;
+            myerror(ss.str());
+            continue;
+          }
+          ostringstream ss;
+          ss << "----> Subproblem " << res.id << " done ("
+             << ++done << '/' << m_subprobCount << ")." << endl;
+          myprint(ss.str());
+          vector<pair<count_t, count_t> > counts;
+          if (applyResult(res.id, res, counts))
+            m_extCounts[res.id] = counts.front();
+          m_extParsed[res.id] = true;
+        }
+      } else {
+        // end of data, worker is done
+        bool broken = readers[it->fd].error() || readers[it->fd].pending();
+        close(it->fd);
+        close(worker.boundFd);
+        running.erase(it->fd);
+        readers.erase(it->fd);
+        int status = 0;
+        waitpid(worker.pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || broken) {
+          ostringstream ss;
+          ss << "Local worker for subproblem " << joinIds(ids) << " failed." << endl;
+          myprint(ss.str());
+        }
+      }
+
+      // worker exceeded its budget and the subproblem was re-split?
+      if (m_external.size() > m_subprobCount) {
+        size_t first = m_subprobCount;
+        m_subprobCount = m_external.size();
+        m_extParsed.resize(m_subprobCount, false);
+        m_extCounts.resize(m_subprobCount);
+        // replace subproblem file atomically, starting workers might be reading it
+        string subprobFile = filename(PREFIX_SUB,".gz");
+        string tempFile = subprobFile + ".tmp";
+        if (!writeSubproblemFile(m_external, tempFile)
+            || rename(tempFile.c_str(), subprobFile.c_str())) {
+          myerror("Error writing re-split subproblems.\n");
+          return false;
+        }
+        for (size_t id = first; id < m_subprobCount; ++id) {
+          pair<double, size_t> job(m_external[id]->getComplexityEstimate(), batches.size());
+          batches.push_back(vector<size_t>(1, id));
+          jobs.insert(upper_bound(jobs.begin(), jobs.end(), job), job);
+        }
+        ++resplits;
+      }
+
+      double cur = getCurOptValue();
+      if (!ISNAN(cur) && (ISNAN(bound) || cur > bound)) {
+        bound = cur;
+        ++broadcasts;
+        for (map<int, LocalWorker>::iterator itW = running.begin(); itW != running.end(); ++itW)
+          BoundChannel::writePipe(itW->second.boundFd, bound);
+        ostringstream ss2;
+        ss2 << "Sent lower bound " << bound << " to " << running.size() << " workers." << endl;
+        myprint(ss2.str());
+      }
+    }
+  }
+
+  ostringstream ss;
+  ss << "Local jobs done, " << broadcasts << " bound updates sent, "
+     << resplits << " subproblems re-split." << endl;
+  myprint(ss.str());
+  return true;
+#endif
+}
+
+
+void ParallelManager::packJobs(vector<vector<size_t> >& jobs) const {
+  vector<pair<double, size_t> > order;
+  order.reserve(m_subprobCount);
+  for (size_t id = 0; id < m_subprobCount; ++id)
+    order.push_back(make_pair(m_external.at(id)->getComplexityEstimate(), id));
+  sort(order.rbegin(), order.rend());
+
+  // estimates are log10 of the node count
+  double limit = (m_options->batch_nodes == NONE) ? 0.0 : m_options->batch_nodes * 1e5;
+  double load = 0.0;
+  jobs.clear();
+  for (vector<pair<double, size_t> >::const_iterator it = order.begin(); it != order.end(); ++it) {
+    double nodes = pow(10.0, it->first);
+    if (jobs.empty() || load + nodes > limit) {
+      jobs.push_back(vector<size_t>());
+      load = 0.0;
+    }
+    jobs.back().push_back(it->second);
+    load += nodes;
+  }
+}
+
+
+void ParallelManager::workerArguments(const vector<size_t>& ids, vector<string>& args) const {
+  ostringstream subprob, ibound, cbound, subOrder, solution, bound;
+  subprob << filename(PREFIX_SUB,".gz") << ':' << joinIds(ids);
+  ibound << m_options->ibound;
+  cbound << m_options->cbound_worker;
+  subOrder << m_options->subprobOrder;
+  solution << "/dev/fd/" << WORKER_SOLUTION_FD;
+  bound << "/dev/fd/" << WORKER_BOUND_FD;
+
+  args.clear();
+  args.push_back(m_options->workerExecutable);
+  args.push_back("-f"); args.push_back(m_options->out_reducedFile);
+  if (!m_options->in_evidenceFile.empty()) {
+    args.push_back("-e"); args.push_back(m_options->in_evidenceFile);
+  }
+  args.push_back("-o"); args.push_back(m_options->in_orderingFile);
+  args.push_back("-s"); args.push_back(subprob.str());
+  args.push_back("-i"); args.push_back(ibound.str());
+  args.push_back("-j"); args.push_back(cbound.str());
+  args.push_back("--result-log"); args.push_back(solution.str());
+  args.push_back("-r"); args.push_back(subOrder.str());
+  args.push_back("-t"); args.push_back("0");
+  args.push_back("--bound-updates"); args.push_back(bound.str());
+  if (m_options->split_time != NONE) {
+    ostringstream t; t << m_options->split_time;
+    args.push_back("--split-time"); args.push_back(t.str());
+  }
+  if (m_options->split_nodes != NONE) {
+    ostringstream t; t << m_options->split_nodes;
+    args.push_back("--split-nodes"); args.push_back(t.str());
+  }
+}
+
+
 bool ParallelManager::readExtResults() {
   myprint("Parsing external results.\n");
 
   vector<pair<count_t, count_t> > nodecounts;
   nodecounts.reserve(m_external.size());
 
+  // Results appended to a shared log by the workers? Then read all records
+  // up front, first one for each subproblem counts.
+  vector<SubproblemResult> logged;
+  vector<int> logIdx;
+  if (m_extParsed.empty() && !m_options->out_resultLog.empty()) {
+    if (!ResultReader::readFile(m_options->out_resultLog, logged)) {
+      ostringstream ss;
+      ss << "Error reading result log " << m_options->out_resultLog
+         << ", got " << logged.size() << " records" << endl;
+      myerror(ss.str());
+    }
+    logIdx.resize(m_subprobCount, NONE);
+    for (size_t i = 0; i < logged.size(); ++i) {
+      int id = logged[i].id;
+      if (id >= 0 && (size_t) id < m_subprobCount && logIdx[id] == NONE)
+        logIdx[id] = i;
+    }
+  }
+
   bool success = true;
   for (size_t id=0; id<m_subprobCount; ++id) {
 
     SearchNode* node = m_external.at(id);
 
+    // Solution received from local worker pool?
+    if (!m_extParsed.empty()) {
+      if (!m_extParsed.at(id) && !node->isErrExt()) {
+        ostringstream ss;
+        ss << "Error: solution " << id << " from local worker unavailable" << endl;
+        myerror(ss.str());
+        node->setErrExt();  // don't count for CSV outout check
+      }
+      if (node->isErrExt()) {  // parsing failed
+        success = false;
+      } else {
+        nodecounts.push_back(m_extCounts.at(id));
+      }
+      continue;
+    }
+
+    // Solution taken from result log?
+    if (!logIdx.empty()) {
+      if (logIdx[id] == NONE) {
+        ostringstream ss;
+        ss << "Error: solution " << id << " missing from result log" << endl;
+        myerror(ss.str());
+        node->setErrExt();  // don't count for CSV outout check
+        success = false;
+      } else {
+        success = applyResult(id, logged[logIdx[id]], nodecounts) && success;
+      }
+      continue;
+    }
+
     // Read solution from file
     string solutionFile = filename(PREFIX_SOL,".gz",id);
     {
@@ -592,88 +999,131 @@ bool ParallelManager::readExtResults() {
       }
     }
     igzstream in(solutionFile.c_str(), ios::binary | ios::in);
+    success = readExtResult(id, in, nodecounts) && success;
+    // done reading input file
+    in.close();
+  }
+
+  reportPredictionError(nodecounts);
+  myprint("Writing CSV stats.\n");
+  writeStatsCSV(m_external, &nodecounts);
 
-    double optCost;
-    BINREAD(in, optCost); // read opt. cost
-//    if (ISNAN(optCost)) optCost = ELEM_ZERO;
+  return success;
+}
 
-    count_t nodesOR, nodesAND;
-    BINREAD(in, nodesOR);
-    BINREAD(in, nodesAND);
 
-    m_space->stats.numORext += nodesOR;
-    m_space->stats.numANDext += nodesAND;
+bool ParallelManager::readExtResult(size_t id, istream& in,
+                                    vector<pair<count_t, count_t> >& nodecounts) {
+
+  SubproblemResult r;
+  r.id = id;
+  BINREAD(in, r.cost); // read opt. cost
+  BINREAD(in, r.nodesOR);
+  BINREAD(in, r.nodesAND);
 
 #ifndef NO_ASSIGNMENT
-    int32_t n;
-    BINREAD(in, n); // read length of opt. tuple
+  int32_t n = 0;
+  BINREAD(in, n); // read length of opt. tuple
+  int32_t v; // assignment saved as int, regardless of internal type
+  for (int i=0; i<n && in; ++i) {
+    BINREAD(in, v); // read opt. assignments
+    r.assignment.push_back((val_t) v);
+  }
+#endif
 
-    vector<val_t> tup(n,UNKNOWN);
+  // read node profiles
+  int32_t size = 0;
+  count_t c;
+  BINREAD(in, size);
+  for (int i=0; i<size && in; ++i) { // leaf profile
+    BINREAD(in, c);
+    r.leafProfile.push_back(c);
+  }
+  for (int i=0; i<size && in; ++i) { // full node profile
+    BINREAD(in, c);
+    r.nodeProfile.push_back(c);
+  }
 
-    int32_t v; // assignment saved as int, regardless of internal type
-    for (int i=0; i<n; ++i) {
-      BINREAD(in, v); // read opt. assignments
-      tup[i] = (val_t) v;
-    }
+  if (in.fail()) {
+    oss ss;
+    ss << "Solution " << id << " incomplete" << endl;
+    myprint(ss.str());
+    m_external.at(id)->setErrExt();  // to suppress CSV output
+    return false;
+  }
 
-    // Check external tuple size, but allow zero (from NaN solutions)
-    size_t subsize = m_pseudotree->getNode(node->getVar())->getSubprobSize();
-    if (tup.size() > 0 && tup.size() != subsize) {
-      oss ss;
-      ss << "Solution file " << id << " length mismatch, got " << tup.size()
-         << ", expected " << subsize << endl;
-      myprint(ss.str());
-      node->setErrExt();  // to suppress CSV output
-      success = false;
-      continue;
+  // worker stopped for re-splitting? then open root values follow
+  int32_t k = 0;
+  BINREAD(in, k);
+  if (in && k > 0) {
+    int32_t f;
+    for (int i=0; i<k; ++i) {
+      BINREAD(in, f);
+      r.open.push_back(f != 0);
     }
-#endif
+  }
 
-    // read node profiles
-    int32_t size;
-    count_t c;
-    BINREAD(in, size);
-    vector<count_t> leafP, nodeP;
-    leafP.reserve(size);
-    nodeP.reserve(size);
-    for (int i=0; i<size; ++i) { // leaf profile
-      BINREAD(in, c);
-      leafP.push_back(c);
-    }
-    for (int i=0; i<size; ++i) { // full node profile
-      BINREAD(in, c);
-      nodeP.push_back(c);
-    }
+  return applyResult(id, r, nodecounts);
+}
 
-    // done reading input file
-    in.close();
 
-    // remember node counts
-    nodecounts.push_back(make_pair(nodesOR, nodesAND));
-    // Write subproblem solution value and tuple into search node
-    node->setValue(optCost);
+bool ParallelManager::applyResult(size_t id, const SubproblemResult& r,
+                                  vector<pair<count_t, count_t> >& nodecounts) {
+
+  SearchNode* node = m_external.at(id);
+
 #ifndef NO_ASSIGNMENT
-    node->setOptAssig(tup);
+  // Check external tuple size, but allow zero (from NaN solutions)
+  size_t subsize = m_pseudotree->getNode(node->getVar())->getSubprobSize();
+  if (r.assignment.size() > 0 && r.assignment.size() != subsize) {
+    oss ss;
+    ss << "Solution " << id << " length mismatch, got " << r.assignment.size()
+       << ", expected " << subsize << endl;
+    myprint(ss.str());
+    node->setErrExt();  // to suppress CSV output
+    return false;
+  }
 #endif
 
-    ostringstream ss;
-    ss  << "Solution file " << id << " read (" << *node
-        << ") " << nodesOR << " / " << nodesAND
-        << " v:" << node->getValue();
+  m_space->stats.numORext += r.nodesOR;
+  m_space->stats.numANDext += r.nodesAND;
+
+  // remember node counts
+  nodecounts.push_back(make_pair(r.nodesOR, r.nodesAND));
+
+  // worker stopped for re-splitting?
+  if (!r.open.empty()) {
 #ifndef NO_ASSIGNMENT
-    DIAG(ss << " -assignment " << node->getOptAssig());
+    size_t newCount = resplitSubproblem(id, r.cost, r.assignment, r.open);
+#else
+    size_t newCount = resplitSubproblem(id, r.cost, r.open);
 #endif
-    ss << endl;
+    ostringstream ss;
+    ss << "Subproblem " << id << " (" << *node << ") stopped after " << r.nodesOR
+       << " / " << r.nodesAND << " with " << count(r.open.begin(), r.open.end(), true)
+       << " open root values, re-split into " << newCount << " subproblems" << endl;
     myprint(ss.str());
-
-    // propagate result (but don't delete node, needed for stats)
-    m_prop.propagate(node, true, node);
+    return true;
   }
+  // Write subproblem solution value and tuple into search node
+  node->setValue(r.cost);
+#ifndef NO_ASSIGNMENT
+  node->setOptAssig(r.assignment);
+#endif
 
-  myprint("Writing CSV stats.\n");
-  writeStatsCSV(m_external, &nodecounts);
+  ostringstream ss;
+  ss  << "Solution " << id << " read (" << *node
+      << ") " << r.nodesOR << " / " << r.nodesAND
+      << " v:" << node->getValue();
+#ifndef NO_ASSIGNMENT
+  DIAG(ss << " -assignment " << node->getOptAssig());
+#endif
+  ss << endl;
+  myprint(ss.str());
 
-  return success;
+  // propagate result (but don't delete node, needed for stats)
+  m_prop.propagate(node, true, node);
+  return true;
 }
 
 
@@ -822,16 +1272,14 @@ void ParallelManager::writeStatsCSV(const vector<SearchNode*>& subprobs,
 }
 
 
-string ParallelManager::encodeJobs(const vector<SearchNode*>& nodes) const {
-  // Will hold the condor job description for the submission file
-  ostringstream job;
-  string subprobsFile = filename(PREFIX_SUB,".gz");
+bool ParallelManager::writeSubproblemFile(const vector<SearchNode*>& nodes,
+                                          const string& subprobsFile) const {
   ogzstream subprobs(subprobsFile.c_str(), ios::out | ios::binary);
   if (!subprobs) {
     ostringstream ss;
     ss << "Problem writing subproblem file"<< endl;
     myerror(ss.str());
-    return "";
+    return false;
   }
 
   // no. of subproblems to file (id variable used as temp)
@@ -893,6 +1341,16 @@ string ParallelManager::encodeJobs(const vector<SearchNode*>& nodes) const {
 
   // close subproblem file
   subprobs.close();
+  return true;
+}
+
+
+string ParallelManager::encodeJobs(const vector<SearchNode*>& nodes) const {
+  // Will hold the condor job description for the submission file
+  ostringstream job;
+  string subprobsFile = filename(PREFIX_SUB,".gz");
+  if (!writeSubproblemFile(nodes, subprobsFile))
+    return "";
 
   // job string for submission file
   job // special condor attribute
@@ -905,27 +1363,108 @@ string ParallelManager::encodeJobs(const vector<SearchNode*>& nodes) const {
     job << ", " << m_options->in_evidenceFile;
   job << endl;
 
-  string solutionFile = filename(PREFIX_SOL,".$(Process).gz");
-
-  job // command line arguments
-    << "arguments = "
-    << " -f " << m_options->out_reducedFile;
+  // command line arguments, apart from subproblem and solution file
+  ostringstream args;
+  args << " -f " << m_options->out_reducedFile;
   if (!m_options->in_evidenceFile.empty())
-    job << " -e " << m_options->in_evidenceFile;
-  job
+    args << " -e " << m_options->in_evidenceFile;
+  args
     << " -o " << m_options->in_orderingFile
-    << " -s " << subprobsFile << ":$(Process)"
     << " -i " << m_options->ibound
     << " -j " << m_options->cbound_worker
-    << " -c " << solutionFile
     << " -r " << m_options->subprobOrder
-    << " -t 0" << endl;
+    << " -t 0";
+
+  // all workers append to a shared result log (requires a shared file
+  // system), or write one solution file per subproblem
+  string solution = m_options->out_resultLog.empty() ? "" :
+      " --result-log " + m_options->out_resultLog;
+
+  if (m_options->batch_nodes == NONE) {
+    if (solution.empty())
+      solution = " -c " + filename(PREFIX_SOL,".$(Process).gz");
+    job << "arguments = " << args.str()
+        << " -s " << subprobsFile << ":$(Process)"
+        << solution << endl;
+    job << "queue " << m_subprobCount << endl;
+    return job.str();
+  }
 
-  job << "queue " << m_subprobCount << endl;
+  // batched jobs, the worker writes one solution file per subproblem id
+  vector<vector<size_t> > jobs;
+  packJobs(jobs);
+  if (solution.empty())
+    solution = " -c " + filename(PREFIX_SOL,".%ID%.gz");
+  for (vector<vector<size_t> >::const_iterator it = jobs.begin(); it != jobs.end(); ++it) {
+    job << "arguments = " << args.str()
+        << " -s " << subprobsFile << ':' << joinIds(*it)
+        << solution << endl;
+    job << "queue" << endl;
+  }
   return job.str();
 }
 
 
+size_t ParallelManager::resplitSubproblem(size_t id, double value,
+#ifndef NO_ASSIGNMENT
+                                          const vector<val_t>& tuple,
+#endif
+                                          const vector<bool>& open) {
+  SearchNode* node = m_external.at(id);
+  assert(node && node->getType() == NODE_OR);
+  int var = node->getVar();
+
+  size_t localCount = m_local.size();
+  vector<SearchNode*> chi, newNodes;
+
+  // node has to remain in memory for stats, so propagation is limited to it
+  syncAssignment(node);
+  if (generateChildrenOR(node, chi)) {
+    m_prop.propagate(node, true, node);
+    return 0; // no children
+  }
+
+  // root value of the worker's best solution, if any
+  val_t bestVal = NONE;
+#ifndef NO_ASSIGNMENT
+  if (!tuple.empty())
+    bestVal = tuple.at(m_pseudotree->getNode(var)->getSubprobVarMap().at(var));
+#endif
+
+  bool closedBest = false;
+  for (vector<SearchNode*>::iterator it=chi.begin(); it!=chi.end(); ++it) {
+    SearchNode* c = *it;
+    int val = c->getVal();
+    if (val >= (int) open.size() || open[val]) {
+      expandFrontierAND(c, newNodes, node);
+      continue;
+    }
+    // value fully solved by the worker, only the best one carries its solution
+    if (!closedBest && !ISNAN(value) && (bestVal == NONE || val == bestVal)) {
+      c->setValue(value OP_DIVIDE c->getLabel());
+#ifndef NO_ASSIGNMENT
+      c->setOptAssig(tuple);
+#endif
+      closedBest = true;
+    } else {
+      c->setValue(ELEM_ZERO);
+    }
+    m_prop.propagate(c, true, node);
+  }
+
+  for (size_t i = localCount; i < m_local.size(); ++i)
+    solveLocal(m_local[i], node);
+
+  for (vector<SearchNode*>::iterator it=newNodes.begin(); it!=newNodes.end(); ++it) {
+    (*it)->setInitialBound(lowerBound(*it));
+    evaluate(*it);
+    (*it)->setExtern();
+    m_external.push_back(*it);
+  }
+  return newNodes.size();
+}
+
+
 bool ParallelManager::isEasy(const SearchNode* node) const {
   assert(node);
 
@@ -943,6 +1482,17 @@ bool ParallelManager::isEasy(const SearchNode* node) const {
 }
 
 
+bool ParallelManager::expandStartAND(SearchNode* n, vector<SearchNode*>& out) {
+  assert(n && n->getType() == NODE_AND);
+  doProcess(n);
+  if (generateChildrenAND(n, out)) {
+    m_prop.propagate(n, true);
+    return true;  // no children
+  }
+  return false;
+}
+
+
 /* expands a node -- assumes OR node! Will generate descendant OR nodes
  * (via intermediate AND nodes) and put them in the referenced vector */
 bool ParallelManager::deepenFrontier(SearchNode* n, vector<SearchNode*>& out) {
@@ -953,7 +1503,7 @@ bool ParallelManager::deepenFrontier(SearchNode* n, vector<SearchNode*>& out) {
   }
 
   assert(n && n->getType() == NODE_OR);
-  vector<SearchNode*> chi, chi2;
+  vector<SearchNode*> chi;
 
   // first generate intermediate AND nodes
   if (generateChildrenOR(n,chi)) {
@@ -961,43 +1511,104 @@ bool ParallelManager::deepenFrontier(SearchNode* n, vector<SearchNode*>& out) {
     return true; // no children
   }
 
+  // generate OR children of all AND nodes at once, for parallel lookahead
+  if (m_options->lookahead_threads > 1) {
+    expandFrontierAND(chi, out);
+    return false;
+  }
+
   // for each AND node, generate OR children
   for (vector<SearchNode*>::iterator it=chi.begin(); it!=chi.end(); ++it) {
     DIAG(oss ss; ss << '\t' << *it << ": " << *(*it) << " (l=" << (*it)->getLabel() << ")" << endl; myprint(ss.str());)
+    expandFrontierAND(*it, out);
+  }
 
-    doProcess(*it);
-    if (generateChildrenAND(*it,chi2)) {
-      m_prop.propagate(*it, true);
+  return false; // default false
+}
+
+
+bool ParallelManager::expandFrontierAND(SearchNode* n, vector<SearchNode*>& out,
+                                        SearchNode* upperLimit) {
+  assert(n && n->getType() == NODE_AND);
+  vector<SearchNode*> chi;
+
+  doProcess(n);
+  if (generateChildrenAND(n,chi)) {
+    m_prop.propagate(n, true, upperLimit);
+    return true;
+  }
+  DIAG( for (vector<SearchNode*>::iterator it=chi.begin(); it!=chi.end(); ++it) {oss ss; ss << "\t  " << *it << ": " << *(*it) << endl; myprint(ss.str());} )
+  for (vector<SearchNode*>::iterator it=chi.begin(); it!=chi.end(); ++it) {
+
+    // Apply LDS if mini buckets are accurate
+    if (applyLDS(*it)) {
+      m_prop.propagate(*it, true, upperLimit);
+      continue; // skip to next
+    }
+    // Apply AOBB to sample dynamic features
+    if (applyAOBB(*it, m_options->aobbLookahead * m_problem->getN())) {
+      m_prop.propagate(*it, true, upperLimit);
       continue;
     }
-    DIAG( for (vector<SearchNode*>::iterator it=chi2.begin(); it!=chi2.end(); ++it) {oss ss; ss << "\t  " << *it << ": " << *(*it) << endl; myprint(ss.str());} )
-    for (vector<SearchNode*>::iterator it=chi2.begin(); it!=chi2.end(); ++it) {
 
-      // Apply LDS if mini buckets are accurate
-      if (applyLDS(*it)) {
-        m_prop.propagate(*it, true);
-        continue; // skip to next
-      }
-      // Apply AOBB to sample dynamic features
-      if (applyAOBB(*it, m_options->aobbLookahead * m_problem->getN())) {
-        m_prop.propagate(*it, true);
-        continue;
-      }
+    if (doCaching(*it)) {
+      m_prop.propagate(*it, true, upperLimit); continue;
+    } else if (doPruning(*it)) {
+      m_prop.propagate(*it, true, upperLimit); continue;
+    } else if (isEasy(*it)) {
+      m_local.push_back(*it);
+    } else {
+      out.push_back(*it);
+    }
+  }
 
-      if (doCaching(*it)) {
-        m_prop.propagate(*it,true); continue;
-      } else if (doPruning(*it)) {
-        m_prop.propagate(*it,true); continue;
-      } else if (isEasy(*it)) {
-        m_local.push_back(*it);
-      } else {
-        out.push_back(*it);
-      }
+  return false;
+}
+
+
+void ParallelManager::expandFrontierAND(const vector<SearchNode*>& nodes,
+                                        vector<SearchNode*>& out, SearchNode* upperLimit) {
+  // generate all OR children and apply LDS right away
+  vector<SearchNode*> chi, cands;
+  for (vector<SearchNode*>::const_iterator it=nodes.begin(); it!=nodes.end(); ++it) {
+    assert(*it && (*it)->getType() == NODE_AND);
+    doProcess(*it);
+    chi.clear();
+    if (generateChildrenAND(*it, chi)) {
+      m_prop.propagate(*it, true, upperLimit);
+      continue;
+    }
+    for (vector<SearchNode*>::iterator jt=chi.begin(); jt!=chi.end(); ++jt) {
+      if (applyLDS(*jt))
+        m_prop.propagate(*jt, true, upperLimit);
+      else
+        cands.push_back(*jt);
     }
-    chi2.clear(); // prepare for next AND node
   }
 
-  return false; // default false
+  // AOBB lookahead for all remaining children in parallel
+  vector<LookaheadJob> jobs;
+  applyAOBB(cands, m_options->aobbLookahead * m_problem->getN(), jobs);
+
+  // merge results in order, as if the lookahead was applied one by one
+  for (size_t i = 0; i < cands.size(); ++i) {
+    SearchNode* node = cands[i];
+    if (mergeLookahead(jobs[i])) {
+      m_prop.propagate(node, true, upperLimit);
+      continue;
+    }
+
+    syncAssignment(node);  // for the cache context
+    if (doCaching(node)) {
+      m_prop.propagate(node, true, upperLimit);
+    } else if (doPruning(node)) {
+      m_prop.propagate(node, true, upperLimit);
+    } else if (isEasy(node)) {
+      m_local.push_back(node);
+    } else {
+      out.push_back(node);
+    }
+  }
 }
 
 
@@ -1052,6 +1663,12 @@ double ParallelManager::evaluate(SearchNode* node) const {
       - ( 1.06230e-03 * (lb)*(avgNodeD))  + ( 1.69370e-03 * (lb)*(avgLeafD))  + ( 1.39504e-03 * (lb)*(Vars))  - ( 7.41810e-03 * (lb)*(Leafs))  - ( 2.40857e-04 * (lb)*(Hmax))  - ( 3.04937e-03 * (ub)*(ub))  - ( 7.36406e-04 * (ub)*(ub-lb))  + ( 9.39502e-04 * (ub)*(D))  - ( 8.06125e-04 * (ub)*(WCsdv))  - ( 1.54377e-02 * (ub-lb)*(ub-lb))  + ( 3.90821e-04 * (ub-lb)*(avgNodeD))  + ( 1.20563e-02 * (ub-lb)*(D))  - ( 6.50204e-04 * (ub-lb)*(Vars))  + ( 2.60533e-04 * (ub-lb)*(Leafs))  - ( 3.72410e-02 * (ub-lb)*(WCmax))  + ( 1.00336e-02 * (ub-lb)*(Hmax))  + ( 7.41045e-03 * (ub-lb)*(Hsdv))  + ( 8.60623e-03 * (ub-lb)*(Hmed))  - ( 9.21925e-04 * (rPruned)*(Vars))  + ( 1.46400e-02 * (rDead)*(Vars))  + ( 2.89068e-03 * (rLeaf)*(Vars))  + ( 1.43511e-03 * (avgNodeD)*(avgNodeD))  - ( 5.70504e-04 * (avgNodeD)*(Vars))  + ( 1.68691e-03 * (avgNodeD)*(Leafs))  - ( 1.79182e-03 * (avgNodeD)*(Hmed))  + ( 3.72780e-04 * (avgLeafD)*(D))  + ( 4.70759e-04 * (avgLeafD)*(Vars))  - ( 1.65965e-03 * (avgLeafD)*(Leafs))  + ( 1.51711e-03 * (avgLeafD)*(Wmax))  + ( 5.29760e-03 * (avgLeafD)*(Wsdv))  - ( 1.72148e-03 * (avgLeafD)*(Hmax))  + ( 1.15015e-02 * (avgLeafD)*(Havg))  - ( 7.82195e-03 * (avgLeafD)*(Hmed))  - ( 5.89913e-03 * (avgBraDg)*(Vars))  + ( 4.15688e-03 * (D)*(D))  + ( 1.90502e-04 * (D)*(Vars))  - ( 4.01007e-05 * (D)*(Leafs))  + ( 1.07401e-02 * (D)*(WCmax))  + ( 9.35496e-05 * (Vars)*(Vars))  - ( 1.28385e-03 * (Vars)*(Wmax))  - ( 1.09807e-04 * (Vars)*(Wmed))  + ( 1.14059e-03 * (Vars)*(WCmax))  + ( 3.61452e-03 * (Vars)*(WCavg))  + ( 2.92006e-04 * (Vars)*(WCsdv))  - ( 1.12599e-02 * (Vars)*(Ksdv))  + ( 1.38700e-04 * (Vars)*(Havg))  - ( 4.01527e-04 * (Vars)*(Hsdv))  - ( 4.28666e-04 * (Vars)*(Hmed))  - ( 1.19686e-03 * (Leafs)*(Leafs))  - ( 8.13292e-03 * (Leafs)*(WCmax))  + ( 3.42008e-03 * (Leafs)*(Havg))  - ( 5.46289e-03 * (Wmax)*(Hmax))  + ( 1.62756e-02 * (WCmax)*(WCmax))  + ( 4.64474e-05 * (Hmed)*(Hmed));
 
 
+  if (m_learner->isTrained()) {  // learned model overrides the one above
+    SubproblemStats sub;
+    sub.update(node, ptnode, 0);
+    z = m_learner->predict(sub);
+  }
+
   if (z < 0.0 || z > 100.0) {
     oss ss; ss << "evaluate: unreasonable estimate for node " << *node << ": " << z << endl;
     myprint(ss.str());
@@ -1067,6 +1684,39 @@ double ParallelManager::evaluate(SearchNode* node) const {
 }
 
 
+void ParallelManager::reportPredictionError(
+    const vector<pair<count_t, count_t> >& nodecounts) const {
+  if (!m_learner->isTrained())
+    return;
+
+  double sqErr = 0.0, absErr = 0.0;
+  count_t maxCount = 0, sumCount = 0;
+  size_t n = 0;
+  vector<pair<count_t, count_t> >::const_iterator itCnt = nodecounts.begin();
+  for (vector<SearchNode*>::const_iterator it = m_external.begin();
+       it != m_external.end() && itCnt != nodecounts.end(); ++it) {
+    if ((*it)->isErrExt())
+      continue;  // no counts for this node
+    count_t count = (itCnt++)->second;
+    double err = (*it)->getComplexityEstimate() - log10(max(1.0, (double) count));
+    sqErr += err * err;
+    absErr += fabs(err);
+    maxCount = max(maxCount, count);
+    sumCount += count;
+    ++n;
+  }
+  if (n == 0)
+    return;
+
+  oss ss;
+  ss << "Prediction error on " << n << " subproblems (log10 nodes): RMSE "
+     << sqrt(sqErr / n) << ", MAE " << absErr / n << endl
+     << "Largest subproblem: " << maxCount << " AND nodes, "
+     << (maxCount * n / (double) max(sumCount, (count_t) 1)) << " times the average" << endl;
+  myprint(ss.str());
+}
+
+
 void ParallelManager::resetLocalStack(SearchNode* node) {
   while (!m_stack.empty())
     m_stack.pop();
@@ -1075,13 +1725,13 @@ void ParallelManager::resetLocalStack(SearchNode* node) {
 }
 
 
-void ParallelManager::solveLocal(SearchNode* node) {
+void ParallelManager::solveLocal(SearchNode* node, SearchNode* upperLimit) {
   assert(node && node->getType()==NODE_OR);
   DIAG(ostringstream ss; ss << "Solving subproblem locally: " << *node << endl; myprint(ss.str()));
   syncAssignment(node);
   this->resetLocalStack(node);
   while ( ( node=nextLeaf() ) )
-    m_prop.propagate(node,true);
+    m_prop.propagate(node,true,upperLimit);
 }
 
 
@@ -1177,6 +1827,131 @@ bool ParallelManager::applyAOBB(SearchNode* node, count_t countLimit) {
 }
 
 
+void ParallelManager::applyAOBB(const vector<SearchNode*>& nodes, count_t countLimit,
+                                vector<LookaheadJob>& jobs) {
+  jobs.clear();
+  jobs.reserve(nodes.size());
+  for (vector<SearchNode*>::const_iterator it = nodes.begin(); it != nodes.end(); ++it) {
+    jobs.push_back(LookaheadJob(*it));
+    LookaheadJob& job = jobs.back();
+    job.assig.resize(m_assignment.size(), NONE);
+    const SearchNode* n = *it;
+    while (n->getParent()) {
+      n = n->getParent(); // AND node
+      job.assig.at(n->getVar()) = n->getVal();
+      n = n->getParent(); // OR node
+    }
+    (*it)->getPST(job.pst);  // returns bottom-up PST
+    reverse(job.pst.begin(), job.pst.end());  // invert to make top-down
+  }
+
+  // every job has its own search space, so its outcome does not depend
+  // on which thread runs it or in which order
+  m_nextLookahead = 0;
+  int threads = min<int>(m_options->lookahead_threads, jobs.size());
+  if (threads > 1) {
+    boost::thread_group group;
+    for (int i = 0; i < threads; ++i)
+      group.create_thread(LookaheadThread(this, &jobs, countLimit));
+    group.join_all();
+  } else {
+    lookaheadWorker(jobs, countLimit);
+  }
+}
+
+
+void ParallelManager::lookaheadWorker(vector<LookaheadJob>& jobs, count_t countLimit) {
+  while (true) {
+    size_t i;
+    {
+      boost::mutex::scoped_lock lock(m_mtxLookahead);
+      if (m_nextLookahead >= jobs.size())
+        return;
+      i = m_nextLookahead++;
+    }
+    runLookahead(jobs[i], countLimit);
+  }
+}
+
+
+void ParallelManager::runLookahead(LookaheadJob& job, count_t countLimit) const {
+  // restricting modifies the pseudo tree, so work on a copy
+  Pseudotree pt(*m_pseudotree);
+  SearchSpace space(&pt, m_options);
+  BranchAndBound bab(m_problem, &pt, &space, m_heuristic);
+  bab.restrictSubproblem(job.node->getVar(), job.assig, job.pst);
+#ifndef NO_HEURISTIC
+  bab.finalizeHeuristic();
+#endif
+
+  // no solution reporting, the problem instance is shared
+  BoundPropagator prop(m_problem, &space, !m_options->nocaching);
+  SearchNode* n = bab.nextLeaf();
+  while (n) {
+    // a root that is a leaf right away (e.g. pruned) would get deleted
+    if (n != space.subproblemLocal)
+      prop.propagate(n);
+    n = bab.nextLeaf();
+    if (space.stats.numProcOR + space.stats.numProcAND > countLimit)
+      break;
+  }
+
+  job.complete = (n == NULL);
+  job.value = bab.getCurOptValue();
+#ifndef NO_ASSIGNMENT
+  job.tuple = bab.getCurOptTuple();
+#endif
+  job.stats = space.stats;
+  job.nodeP = bab.getNodeProfile();
+  job.leafP = bab.getLeafProfile();
+}
+
+
+bool ParallelManager::mergeLookahead(const LookaheadJob& job) {
+  SearchNode* node = job.node;
+  const SearchStats& stats = job.stats;
+
+  // add node counts and profiles to the master's
+  m_space->stats.numExpOR += stats.numExpOR;
+  m_space->stats.numExpAND += stats.numExpAND;
+  m_space->stats.numProcOR += stats.numProcOR;
+  m_space->stats.numProcAND += stats.numProcAND;
+  m_space->stats.numLeaf += stats.numLeaf;
+  m_space->stats.numPruned += stats.numPruned;
+  m_space->stats.numPrunedBound += stats.numPrunedBound;
+  m_space->stats.numDead += stats.numDead;
+  int depth = node->getDepth();
+  for (size_t d = 0; d < job.nodeP.size(); ++d) {
+    m_nodeProfile.at(depth + d) += job.nodeP[d];
+    m_leafProfile.at(depth + d) += job.leafP[d];
+  }
+
+  // compute features, profiles are relative to the subproblem root
+  size_t countProc = stats.numProcOR + stats.numProcAND;
+  vector<count_t> zeros(job.nodeP.size(), 0);
+  SubprobFeatures* features = node->getSubprobFeatures();
+  features->ratioPruned = stats.numPruned * 1.0 / countProc;
+  features->ratioDead = stats.numDead * 1.0 / countProc;
+  features->ratioLeaf = stats.numLeaf * 1.0 / countProc;
+  features->avgNodeDepth = computeAvgDepth(zeros, job.nodeP, 0);
+  features->avgLeafDepth = computeAvgDepth(zeros, job.leafP, 0);
+  features->avgBranchDeg = pow(countProc, 1.0 / features->avgLeafDepth);
+
+  if (!ISNAN(job.value)) {
+    node->setValue(job.value);
+#ifndef NO_ASSIGNMENT
+    node->setOptAssig(job.tuple);
+#endif
+    // best solution found so far, propagated as the in-place lookahead would
+    if (!job.complete)
+      m_prop.propagate(node, true, node);
+  }
+  DIAG(oss ss; ss << "Subproblem " << *node << " lookahead with " << countProc << " expansions, "
+       << ((job.complete) ? "complete" : "not complete") << endl; myprint(ss.str());)
+  return job.complete;
+}
+
+
 bool ParallelManager::applyLDS(SearchNode* node) {
   assert(node);
   PseudotreeNode* ptnode = m_pseudotree->getNode(node->getVar());
@@ -1225,7 +2000,7 @@ double ParallelManager::computeAvgDepth(const vector<count_t>& before, const vec
 ParallelManager::ParallelManager(Problem* prob, Pseudotree* pt, SearchSpace* space, Heuristic* heur)
   : Search(prob, pt, space, heur), m_subprobCount(0)
 //    , m_ldsSpace(NULL)
-    , m_prop(prob, space)
+    , m_prop(prob, space), m_nextLookahead(0)
 {
 #ifndef NO_CACHING
   // Init context cache table
@@ -1245,9 +2020,7 @@ ParallelManager::ParallelManager(Problem* prob, Pseudotree* pt, SearchSpace* spa
   m_ldsSearch.reset(new LimitedDiscrepancy(prob, pt, m_space, heur, 0));
   m_ldsProp.reset(new BoundPropagator(prob, m_space, false));  // important: no caching
 
-  // Set up subproblem sampler and complexity prediction
-  m_sampleSpace.reset(new SearchSpace(pt, m_options));
-  m_sampleSearch.reset(new BranchAndBoundSampler(prob, pt, m_sampleSpace.get(), heur));
+  // Set up complexity prediction (sampler is set up in doLearning())
   m_learner.reset(new LinearRegressionLearner(m_options));
 
 }
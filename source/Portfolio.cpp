@@ -0,0 +1,210 @@
+/*
+ * Portfolio.cpp
+ *
+ *  Copyright (C) 2008-2012 Lars Otten
+ *  This file is part of DAOOPT.
+ *
+ *  DAOOPT is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  DAOOPT is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with DAOOPT.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Lars Otten <lotten@ics.uci.edu>
+ */
+
+
+#include "Portfolio.h"
+
+#if not (defined PARALLEL_DYNAMIC || defined PARALLEL_STATIC || defined NOTHREADS)
+
+#include "BoundChannel.h"
+#include "BoundPropagator.h"
+#include "BranchAndBound.h"
+#include "BranchAndBoundRotate.h"
+
+namespace daoopt {
+
+bool Portfolio::parse(const string& spec, vector<PortfolioConfig>& configs) {
+  configs.clear();
+  istringstream ss(spec);
+  string entry;
+  while (getline(ss, entry, ',')) {
+    PortfolioConfig cfg;
+    cfg.name = entry;
+    size_t i = entry.find(':');
+    string type = entry.substr(0, i);
+    if (type == "rotate")
+      cfg.rotate = true;
+    else if (type != "bab")
+      return false;
+    if (i != string::npos) {
+      istringstream order(entry.substr(i+1));
+      if (!(order >> cfg.subprobOrder)
+          || cfg.subprobOrder < SUBPROB_WIDTH_INC || cfg.subprobOrder > SUBPROB_HEUR_DEC)
+        return false;
+    }
+    configs.push_back(cfg);
+  }
+  return !configs.empty();
+}
+
+
+bool Portfolio::init(const vector<PortfolioConfig>& configs) {
+  m_configs = configs;
+  m_bound = m_problem->getSolutionCost();
+#ifndef NO_ASSIGNMENT
+  m_tuple = m_problem->getSolutionAssg();
+#endif
+
+  for (size_t i = 0; i < m_configs.size(); ++i) {
+    ProgramOptions* opt = new ProgramOptions(*m_options);
+    opt->rotate = m_configs[i].rotate;
+    if (m_configs[i].subprobOrder != NONE)
+      opt->subprobOrder = m_configs[i].subprobOrder;
+    m_searchOptions.push_back(opt);
+
+    SearchSpace* space = new SearchSpace(m_pseudotree, opt);
+    m_spaces.push_back(space);
+    if (opt->rotate)
+      m_searches.push_back(new BranchAndBoundRotate(m_problem, m_pseudotree, space, m_heuristic));
+    else
+      m_searches.push_back(new BranchAndBound(m_problem, m_pseudotree, space, m_heuristic));
+
+    // start from the current solution, e.g. from SLS or LDS
+    m_searches[i]->updateSolution(m_bound
+#ifndef NO_ASSIGNMENT
+        , m_tuple
+#endif
+    );
+#ifndef NO_HEURISTIC
+    m_searches[i]->finalizeHeuristic();
+#endif
+  }
+  return true;
+}
+
+
+void Portfolio::run() {
+  cout << "Portfolio of " << m_configs.size() << " searches:";
+  for (size_t i = 0; i < m_configs.size(); ++i)
+    cout << ' ' << m_configs[i].name;
+  cout << endl;
+
+  boost::thread_group group;
+  for (size_t i = 0; i < m_searches.size(); ++i)
+    group.create_thread(PortfolioThread(this, i));
+  group.join_all();
+
+  cout << "Portfolio search " << m_winner << " (" << m_configs[m_winner].name
+       << ") finished first, OR/AND nodes expanded:";
+  for (size_t i = 0; i < m_spaces.size(); ++i)
+    cout << ' ' << m_spaces[i]->stats.numExpOR << '/' << m_spaces[i]->stats.numExpAND;
+  cout << endl;
+}
+
+
+void Portfolio::work(size_t i) {
+  Search* search = m_searches[i];
+  BoundPropagator prop(m_problem, m_spaces[i], !m_options->nocaching);
+  size_t version = m_boundVersion;
+  double best = search->getCurOptValue();
+
+  SearchNode* n = search->nextLeaf();
+  for (count_t leaves = 0; n; ++leaves) {
+    prop.propagate(n);  // solutions are reported through the portfolio
+    double d = search->getCurOptValue();
+    if (!ISNAN(d) && (ISNAN(best) || d > best)) {
+      best = d;
+      report(i, d
+#ifndef NO_ASSIGNMENT
+             , search->getCurOptTuple()
+#endif
+      );
+    }
+    if (leaves % BOUND_POLL_INTERVAL == 0) {
+      if (!poll(i, version))
+        return;  // another search was faster
+      best = search->getCurOptValue();
+    }
+    n = search->nextLeaf();
+  }
+
+  // search space exhausted, the incumbent is optimal
+  boost::mutex::scoped_lock lock(m_mtx);
+  if (m_winner == NONE)
+    m_winner = i;
+}
+
+
+bool Portfolio::report(size_t i, double d
+#ifndef NO_ASSIGNMENT
+                       , const vector<val_t>& tuple
+#endif
+                       ) {
+  boost::mutex::scoped_lock lock(m_mtx);
+  if (!ISNAN(m_bound) && d <= m_bound)
+    return false;
+  m_bound = d;
+#ifndef NO_ASSIGNMENT
+  m_tuple = tuple;
+  m_problem->updateSolution(d, tuple, &m_spaces[i]->stats, true);
+#else
+  m_problem->updateSolution(d, &m_spaces[i]->stats, true);
+#endif
+  ++m_boundVersion;
+  return true;
+}
+
+
+bool Portfolio::poll(size_t i, size_t& version) {
+  boost::mutex::scoped_lock lock(m_mtx);
+  if (m_winner != NONE)
+    return false;
+  if (version != m_boundVersion) {
+    version = m_boundVersion;
+    m_searches[i]->updateSolution(m_bound
+#ifndef NO_ASSIGNMENT
+        , m_tuple
+#endif
+    );
+  }
+  return true;
+}
+
+
+Search* Portfolio::releaseSearch() {
+  assert(m_winner != NONE);
+  Search* s = m_searches[m_winner];
+  m_searches[m_winner] = NULL;
+  return s;
+}
+
+
+SearchSpace* Portfolio::releaseSpace() {
+  assert(m_winner != NONE);
+  SearchSpace* s = m_spaces[m_winner];
+  m_spaces[m_winner] = NULL;
+  return s;
+}
+
+
+Portfolio::~Portfolio() {
+  for (size_t i = 0; i < m_searches.size(); ++i) {
+    delete m_searches[i];
+    delete m_spaces[i];
+    delete m_searchOptions[i];
+  }
+}
+
+}  // namespace daoopt
+
+#endif /* not parallel, threads */
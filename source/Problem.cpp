@@ -27,6 +27,7 @@
 #include <fstream>
 
 
+#include "ResultLog.h"
 #include "UAI2012.h"
 
 namespace daoopt {
@@ -292,6 +293,37 @@ void Problem::saveOrdering(const string& file, const vector<int>& elim) const {
 
 
 
+uint64_t Problem::getFingerprint() const {
+  // FNV-1a over no. of variables, domain sizes and sorted function scopes
+  const uint64_t prime = 1099511628211ULL;
+  uint64_t h = 14695981039346656037ULL;
+  vector<vector<int> > scopes;
+  scopes.reserve(m_functions.size());
+  for (vector<Function*>::const_iterator it = m_functions.begin(); it != m_functions.end(); ++it)
+    scopes.push_back((*it)->getScopeVec());
+  sort(scopes.begin(), scopes.end());
+
+  vector<int> data;
+  data.push_back(m_n);
+  for (vector<val_t>::const_iterator it = m_domains.begin(); it != m_domains.end(); ++it)
+    data.push_back(*it);
+  data.push_back(scopes.size());
+  for (vector<vector<int> >::const_iterator it = scopes.begin(); it != scopes.end(); ++it) {
+    data.push_back(it->size());
+    data.insert(data.end(), it->begin(), it->end());
+  }
+
+  for (vector<int>::const_iterator it = data.begin(); it != data.end(); ++it) {
+    uint32_t x = *it;
+    for (int b = 0; b < 4; ++b, x >>= 8) {
+      h ^= (x & 0xff);
+      h *= prime;
+    }
+  }
+  return h;
+}
+
+
 bool Problem::parseUAI(const string& prob, const string& evid, const string& mmap) {
   {
     ifstream inTemp(prob.c_str());
@@ -514,22 +546,32 @@ bool Problem::parseUAI(const string& prob, const string& evid, const string& mma
 
 
 void Problem::outputAndSaveSolution(const string& file, const SearchStats* nodestats,
-    const vector<count_t>& nodeProf, const vector<count_t>& leafProf, bool toScreen) const {
-
-  bool writeFile = false;
-  if (! file.empty())
-    writeFile = true;
+    const vector<count_t>& nodeProf, const vector<count_t>& leafProf, bool toScreen,
+    const vector<bool>* splitOpen) const {
 
   ogzstream out;
-  if (writeFile) {
+  bool writeFile = false;
+  if (! file.empty()) {
     out.open(file.c_str(), ios::out | ios::trunc | ios::binary);
     if (!out) {
       cerr << "Error writing optimal solution to file " << file << endl;
-      writeFile = false;
       out.close();
+    } else {
+      writeFile = true;
     }
   }
 
+  outputAndSaveSolution(writeFile ? &out : NULL, nodestats, nodeProf, leafProf,
+                        toScreen, splitOpen);
+  if (writeFile)
+    out.close();
+}
+
+
+void Problem::outputAndSaveSolution(ostream* out, const SearchStats* nodestats,
+    const vector<count_t>& nodeProf, const vector<count_t>& leafProf, bool toScreen,
+    const vector<bool>* splitOpen) const {
+
   oss screen;
   screen << "s " << SCALE_LOG(m_curCost);
 #ifndef NO_ASSIGNMENT
@@ -541,20 +583,20 @@ void Problem::outputAndSaveSolution(const string& file, const SearchStats* nodes
   screen << ' ' << assigSize;
 #endif
 
-  if (writeFile) {
-    BINWRITE(out, m_curCost); // mpe solution cost
+  if (out) {
+    BINWRITE(*out, m_curCost); // mpe solution cost
     count_t countOR = 0, countAND = 0;
     if (nodestats) {
       countOR = nodestats->numExpOR;
       countAND = nodestats->numExpAND;
     }
-    BINWRITE(out, countOR);
-    BINWRITE(out, countAND);
+    BINWRITE(*out, countOR);
+    BINWRITE(*out, countAND);
   }
 
 #ifndef NO_ASSIGNMENT
-  if (writeFile) {
-    BINWRITE(out,assigSize); // no. of variables in opt. assignment
+  if (out) {
+    BINWRITE(*out,assigSize); // no. of variables in opt. assignment
   }
 
   // generate full assignment (incl. evidence) if necessary and output
@@ -562,29 +604,64 @@ void Problem::outputAndSaveSolution(const string& file, const SearchStats* nodes
   assignmentForOutput(outputAssig);
   BOOST_FOREACH( int32_t v, outputAssig ) {
     screen << ' ' << v;
-    if (writeFile) BINWRITE(out, v);
+    if (out) BINWRITE(*out, v);
   }
 #endif
 
   // output node profiles in case of subproblem processing
-  if (m_subprobOnly) {
+  if (m_subprobOnly && out) {
     int32_t size = (int32_t) leafProf.size();
-    BINWRITE(out, size);
+    BINWRITE(*out, size);
     // leaf nodes first
     for (vector<count_t>::const_iterator it=leafProf.begin(); it!=leafProf.end(); ++it) {
-      BINWRITE(out,*it);
+      BINWRITE(*out,*it);
     }
     // now full node profile (has same array size)
     for (vector<count_t>::const_iterator it=nodeProf.begin(); it!=nodeProf.end(); ++it) {
-      BINWRITE(out,*it);
+      BINWRITE(*out,*it);
+    }
+    // open root values if subproblem was stopped for re-splitting (zero if none)
+    if (splitOpen) {
+      int32_t k = (int32_t) splitOpen->size();
+      BINWRITE(*out, k);
+      for (vector<bool>::const_iterator it=splitOpen->begin(); it!=splitOpen->end(); ++it) {
+        int32_t f = *it ? 1 : 0;
+        BINWRITE(*out, f);
+      }
     }
   }
 
   screen << endl;
   if (toScreen)
     cout << screen.str();
-  if (writeFile)
-    out.close();
+}
+
+
+bool Problem::appendResult(const string& log, int id, const SearchStats* nodestats,
+    const vector<count_t>& nodeProf, const vector<count_t>& leafProf,
+    const vector<bool>* splitOpen) const {
+  SubproblemResult r;
+  r.id = id;
+  r.cost = m_curCost;
+  if (nodestats) {
+    r.nodesOR = nodestats->numExpOR;
+    r.nodesAND = nodestats->numExpAND;
+  }
+#ifndef NO_ASSIGNMENT
+  assignmentForOutput(r.assignment);
+#endif
+  if (m_subprobOnly) {
+    r.leafProfile = leafProf;
+    r.nodeProfile = nodeProf;
+  }
+  if (splitOpen)
+    r.open = *splitOpen;
+
+  if (!ResultLog::append(log, r)) {
+    cerr << "Error appending solution to result log " << log << endl;
+    return false;
+  }
+  return true;
 }
 
 
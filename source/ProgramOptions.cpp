@@ -42,11 +42,12 @@ ProgramOptions* parseCommandLine(int ac, char** av) {
       ("evid-file,e", po::value<string>(), "path to optional evidence file")
       ("mmap-file", po::value<string>(), "path to optional marginal MAP variables file")
       ("ordering,o", po::value<string>(), "read elimination ordering from this file (first to last)")
+      ("orderCache", po::value<string>(), "directory to cache best orderings across runs (by problem structure)")
       ("adaptive", "enable adaptive ordering scheme")
       ("minibucket", po::value<string>(), "path to read/store mini bucket heuristic")
-      ("subproblem,s", po::value<string>(), "limit search to subproblem specified in file")
+      ("subproblem,s", po::value<string>(), "limit search to subproblem specified in file (file:id, or file:id,id,... for a batch)")
       ("suborder,r",po::value<int>()->default_value(0), "subproblem order (0:width-inc 1:width-dec 2:heur-inc 3:heur-dec)")
-      ("sol-file,c", po::value<string>(), "path to output optimal solution to")
+      ("sol-file,c", po::value<string>(), "path to output optimal solution to (batches: %ID% is replaced by subproblem id)")
       ("ibound,i", po::value<int>()->default_value(10), "i-bound for mini bucket heuristics")
       ("cbound,j", po::value<int>()->default_value(1000), "context size bound for caching")
 #if defined PARALLEL_DYNAMIC || defined PARALLEL_STATIC
@@ -64,6 +65,10 @@ ProgramOptions* parseCommandLine(int ac, char** av) {
       ("orderIter,t", po::value<int>()->default_value(25), "iterations for finding ordering")
       ("orderTime", po::value<int>()->default_value(-1), "maximum time for finding ordering")
       ("orderTolerance", po::value<int>()->default_value(0), "allowed deviation from minfill suggested optimal")
+      ("orderObjective", po::value<int>()->default_value(0), "ordering objective (0:width 1:state-space 2:cache-bytes 3:height)")
+#ifndef NOTHREADS
+      ("orderThreads", po::value<int>()->default_value(1), "number of threads for finding ordering")
+#endif
       ("max-width", po::value<int>(), "max. induced width to process, abort otherwise")
 #if defined PARALLEL_DYNAMIC || defined PARALLEL_STATIC
       ("cutoff-depth,d", po::value<int>()->default_value(-1), "cutoff depth for central search")
@@ -77,26 +82,61 @@ ProgramOptions* parseCommandLine(int ac, char** av) {
       ("max-sub", po::value<int>()->default_value(-1), "only generate the first few subproblems (for testing)")
       ("tag", po::value<string>(), "tag of the parallel run (to differentiate filenames etc.)")
 #endif
+#ifdef PARALLEL_DYNAMIC
+      ("threaded", "solve subproblems in threads of the master process instead of Condor")
+#endif
 #ifdef PARALLEL_STATIC
       ("pre", "perform preprocessing and generate subproblems only")
       ("post", "read previously solved subproblems and compile solution")
       ("sampledepth", po::value<int>()->default_value(10), "Randomness branching depth for initial sampling")
       ("samplesizes", po::value<string>(), "Sequence of sample sizes for complexity prediction (in 10^5 nodes)")
       ("samplerepeat", po::value<int>()->default_value(1), "Number of sample sequence repeats")
+      ("learnreg", po::value<double>()->default_value(1.0), "Regularization weight for complexity prediction model")
+      ("learnmodel", po::value<string>(), "Complexity prediction model to load (from earlier run)")
       ("lookahead", po::value<int>()->default_value(5), "AOBB subproblem lookahead factor (multiplied by no. of problem variables)")
+      ("lookahead-threads", po::value<int>()->default_value(1), "number of threads for AOBB subproblem lookahead")
+      ("pool", po::value<int>(), "solve subproblems with this many local worker processes instead of Condor")
+      ("worker", po::value<string>(), "worker executable for local process pool (default: <executable>-worker)")
+      ("batch-nodes", po::value<int>(), "pack subproblems into worker jobs of up to this many predicted nodes (* 10^5)")
 #endif
       ("bound-file,b", po::value<string>(), "file with initial lower bound on solution cost")
+#ifndef PARALLEL_DYNAMIC
+      ("split-time", po::value<int>(), "time budget (sec) for a subproblem, re-split once exceeded (with --pool)")
+      ("split-nodes", po::value<int>(), "node budget (* 10^5) for a subproblem, re-split once exceeded (with --pool)")
+      ("result-log", po::value<string>(), "append subproblem results to this log as binary records (shared by all Condor jobs)")
+#endif
+#if not (defined PARALLEL_DYNAMIC || defined PARALLEL_STATIC)
+      ("bound-updates", po::value<string>(), "file or pipe to poll for lower bound updates from the master (subproblems only)")
+#ifndef NOTHREADS
+      ("portfolio", po::value<string>(), "run several searches in threads, sharing the best solution (comma-separated, each bab|rotate[:suborder])")
+      ("compThreads", po::value<int>()->default_value(1), "solve independent problem components as separate searches in this many threads")
+#endif
+#endif
       ("initial-bound", po::value<double>(), "initial lower bound on solution cost" )
 #ifdef ENABLE_SLS
       ("slsX", po::value<int>()->default_value(0), "Number of initial SLS iterations")
       ("slsT", po::value<int>()->default_value(5), "Time per SLS iteration")
+#ifndef NOTHREADS
+      ("slsThreads", po::value<int>()->default_value(1), "Number of threads for SLS iterations (with different seeds)")
+#endif
+#if not (defined PARALLEL_DYNAMIC || defined PARALLEL_STATIC || defined NOTHREADS)
+      ("slsLive", "run SLS concurrently with search, restarting from the search's solutions")
+#endif
 #endif
       ("lds,a",po::value<int>()->default_value(-1), "run initial LDS search with given limit (-1: disabled)")
+#ifndef NOTHREADS
+      ("ldsThreads", po::value<int>()->default_value(1), "run LDS iteratively with limits 0..lds in this many threads, sharing the best solution")
+      ("ldsTime", po::value<int>(), "time budget (sec) for iterative LDS")
+#endif
       ("memlimit,m", po::value<int>()->default_value(-1), "approx. memory limit for mini buckets (in MByte)")
       ("seed", po::value<int>(), "seed for random number generator, time() otherwise")
       ("or", "use OR search (build pseudo tree as chain)")
       ("nocaching", "disable context-based caching during search")
+      ("nofc", "disable forward checking of zero function entries during search")
       ("nosearch,n", "perform preprocessing, output stats, and exit")
+#ifndef NOTHREADS
+      ("nopipeline", "don't search for the ordering concurrently with heuristic preprocessing and SLS")
+#endif
 #if not (defined PARALLEL_DYNAMIC || defined PARALLEL_STATIC)
       ("reduce", po::value<string>(), "path to output the reduced network to (removes evidence and unary variables)")
 #endif
@@ -130,6 +170,9 @@ ProgramOptions* parseCommandLine(int ac, char** av) {
     if (vm.count("ordering"))
       opt->in_orderingFile = vm["ordering"].as<string>();
 
+    if (vm.count("orderCache"))
+      opt->in_orderingCache = vm["orderCache"].as<string>();
+
     if (vm.count("adaptive"))
       opt->autoIter = true;
     else
@@ -174,6 +217,15 @@ ProgramOptions* parseCommandLine(int ac, char** av) {
       opt->order_timelimit = vm["orderTime"].as<int>();
     if (vm.count("orderTolerance"))
       opt->order_tolerance = vm["orderTolerance"].as<int>();
+    if (vm.count("orderObjective")) {
+      opt->order_objective = vm["orderObjective"].as<int>();
+      if (opt->order_objective < 0 || opt->order_objective > 3) {
+        cout << endl << desc << endl;
+        exit(0);
+      }
+    }
+    if (vm.count("orderThreads"))
+      opt->order_threads = vm["orderThreads"].as<int>();
 
     if (vm.count("max-width"))
       opt->maxWidthAbort = vm["max-width"].as<int>();
@@ -206,17 +258,39 @@ ProgramOptions* parseCommandLine(int ac, char** av) {
 
     if (vm.count("bound-file"))
       opt->in_boundFile = vm["bound-file"].as<string>();
+    if (vm.count("bound-updates"))
+      opt->in_boundUpdates = vm["bound-updates"].as<string>();
+    if (vm.count("portfolio"))
+      opt->portfolio = vm["portfolio"].as<string>();
+    if (vm.count("compThreads"))
+      opt->compThreads = vm["compThreads"].as<int>();
+
+    if (vm.count("result-log"))
+      opt->out_resultLog = vm["result-log"].as<string>();
+
+    if (vm.count("split-time"))
+      opt->split_time = vm["split-time"].as<int>();
+    if (vm.count("split-nodes"))
+      opt->split_nodes = vm["split-nodes"].as<int>();
 
     if (vm.count("initial-bound"))
       opt->initialBound = vm["initial-bound"].as<double>();
 
     if (vm.count("lds"))
       opt->lds = vm["lds"].as<int>();
+    if (vm.count("ldsThreads"))
+      opt->ldsThreads = vm["ldsThreads"].as<int>();
+    if (vm.count("ldsTime"))
+      opt->ldsTime = vm["ldsTime"].as<int>();
 
     if (vm.count("slsX"))
       opt->slsIter = vm["slsX"].as<int>();
     if (vm.count("slsT"))
       opt->slsTime = vm["slsT"].as<int>();
+    if (vm.count("slsThreads"))
+      opt->slsThreads = vm["slsThreads"].as<int>();
+    if (vm.count("slsLive"))
+      opt->slsLive = true;
 
     if (vm.count("memlimit"))
       opt->memlimit = vm["memlimit"].as<int>();
@@ -231,11 +305,19 @@ ProgramOptions* parseCommandLine(int ac, char** av) {
     else
       opt->nosearch = false;
 
+    if (vm.count("nopipeline"))
+      opt->nopipeline = true;
+
     if (vm.count("nocaching"))
       opt->nocaching = true;
     else
       opt->nocaching = false;
 
+    if (vm.count("nofc"))
+      opt->nofwdcheck = true;
+    else
+      opt->nofwdcheck = false;
+
     if (vm.count("rotate"))
       opt->rotate = true;
     if (vm.count("rotatelimit"))
@@ -261,6 +343,8 @@ ProgramOptions* parseCommandLine(int ac, char** av) {
 
     if (vm.count("local"))
       opt->par_solveLocal = true;
+    if (vm.count("threaded"))
+      opt->par_threaded = true;
     if (vm.count("pre"))
       opt->par_preOnly = true;
     else if (vm.count("post"))
@@ -272,9 +356,24 @@ ProgramOptions* parseCommandLine(int ac, char** av) {
       opt->sampleSizes = vm["samplesizes"].as<string>();
     if (vm.count("samplerepeat"))
       opt->sampleRepeat = vm["samplerepeat"].as<int>();
+    if (vm.count("learnreg"))
+      opt->learnRegularization = vm["learnreg"].as<double>();
+    if (vm.count("learnmodel"))
+      opt->in_learnModel = vm["learnmodel"].as<string>();
 
     if (vm.count("lookahead"))
       opt->aobbLookahead = vm["lookahead"].as<int>();
+    if (vm.count("lookahead-threads"))
+      opt->lookahead_threads = vm["lookahead-threads"].as<int>();
+
+    if (vm.count("pool"))
+      opt->par_poolSize = vm["pool"].as<int>();
+    if (vm.count("batch-nodes"))
+      opt->batch_nodes = vm["batch-nodes"].as<int>();
+    if (vm.count("worker"))
+      opt->workerExecutable = vm["worker"].as<string>();
+    else
+      opt->workerExecutable = opt->executableName + "-worker";
 
     if (vm.count("reduce"))
       opt->out_reducedFile = vm["reduce"].as<string>();
@@ -91,7 +91,7 @@ void Pseudotree::addDomainInfo(const vector<val_t>& domains) {
 }
 
 /* computes an elimination order into 'elim' and returns its tree width */
-int Pseudotree::eliminate(Graph G, vector<int>& elim, int limit, int tolerance) {
+int Pseudotree::eliminate(Graph G, vector<int>& elim, int limit, int tolerance, RandStream* rs) {
 
   int width = UNKNOWN;
   int n = G.getStatNodes();
@@ -187,7 +187,7 @@ int Pseudotree::eliminate(Graph G, vector<int>& elim, int limit, int tolerance)
     // Pick one of the minimal score nodes (with score >= 1),
     // breaking ties randomly
     if (tolerance == 0) {
-      nextNode = candidates[0]->at(rand::next(candidates[0]->size()));
+      nextNode = candidates[0]->at(rs ? rs->next(candidates[0]->size()) : rand::next(candidates[0]->size()));
     } else {
       size_t candTotal = 0;
       for (int i=0; i<=tolerance; ++i) {
@@ -195,7 +195,7 @@ int Pseudotree::eliminate(Graph G, vector<int>& elim, int limit, int tolerance)
           break;
         candTotal += candidates[i]->size();
       }
-      size_t choice = rand::next(candTotal);
+      size_t choice = rs ? rs->next(candTotal) : rand::next(candTotal);
       for (int i=0; i<=tolerance; ++i) {
         if (choice < candidates[i]->size()) {
           nextNode = candidates[i]->at(choice);
@@ -0,0 +1,238 @@
+/*
+ * ResultLog.cpp
+ *
+ *  Copyright (C) 2008-2012 Lars Otten
+ *  This file is part of DAOOPT.
+ *
+ *  DAOOPT is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  DAOOPT is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with DAOOPT.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Lars Otten <lotten@ics.uci.edu>
+ */
+
+#include "ResultLog.h"
+
+#include <cerrno>
+#include <cstring>
+#if !defined(WINDOWS)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/* size of the record header: magic, version, reserved, payload size */
+#define RESULT_HEADER_SIZE 12
+
+namespace daoopt {
+
+/* appends the raw bytes of x */
+template <class T>
+inline void putRaw(string& out, const T& x) {
+  out.append((const char*) &x, sizeof(T));
+}
+
+/* copies raw bytes at position pos into x and advances pos, returns false
+ * if that would read beyond size */
+template <class T>
+inline bool getRaw(const char* data, size_t size, size_t& pos, T& x) {
+  if (pos + sizeof(T) > size)
+    return false;
+  memcpy(&x, data + pos, sizeof(T));
+  pos += sizeof(T);
+  return true;
+}
+
+
+void ResultLog::encode(const SubproblemResult& r, string& out) {
+  assert(r.leafProfile.size() == r.nodeProfile.size());
+  string payload;
+  putRaw(payload, r.id);
+  putRaw(payload, r.cost);
+  uint64_t c = r.nodesOR;
+  putRaw(payload, c);
+  c = r.nodesAND;
+  putRaw(payload, c);
+
+  int32_t n = (int32_t) r.assignment.size();
+  putRaw(payload, n);
+  for (vector<val_t>::const_iterator it = r.assignment.begin(); it != r.assignment.end(); ++it) {
+    int32_t v = (int32_t) *it;  // saved as int, regardless of internal type
+    putRaw(payload, v);
+  }
+
+  n = (int32_t) r.leafProfile.size();
+  putRaw(payload, n);
+  for (vector<count_t>::const_iterator it = r.leafProfile.begin(); it != r.leafProfile.end(); ++it) {
+    c = *it;
+    putRaw(payload, c);
+  }
+  for (vector<count_t>::const_iterator it = r.nodeProfile.begin(); it != r.nodeProfile.end(); ++it) {
+    c = *it;
+    putRaw(payload, c);
+  }
+
+  n = (int32_t) r.open.size();
+  putRaw(payload, n);
+  for (vector<bool>::const_iterator it = r.open.begin(); it != r.open.end(); ++it) {
+    uint8_t f = *it ? 1 : 0;
+    putRaw(payload, f);
+  }
+
+  uint32_t magic = RESULT_MAGIC, size = (uint32_t) payload.size();
+  uint16_t version = RESULT_VERSION, reserved = 0;
+  putRaw(out, magic);
+  putRaw(out, version);
+  putRaw(out, reserved);
+  putRaw(out, size);
+  out.append(payload);
+}
+
+
+bool ResultLog::decode(const char* data, size_t size, SubproblemResult& r) {
+  r = SubproblemResult();
+  size_t pos = 0;
+  uint64_t c = 0;
+  int32_t n = 0;
+
+  if (!getRaw(data, size, pos, r.id) || !getRaw(data, size, pos, r.cost))
+    return false;
+  if (!getRaw(data, size, pos, c))
+    return false;
+  r.nodesOR = c;
+  if (!getRaw(data, size, pos, c))
+    return false;
+  r.nodesAND = c;
+
+  if (!getRaw(data, size, pos, n) || n < 0 || pos + n * sizeof(int32_t) > size)
+    return false;
+  r.assignment.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    int32_t v;
+    getRaw(data, size, pos, v);
+    r.assignment.push_back((val_t) v);
+  }
+
+  if (!getRaw(data, size, pos, n) || n < 0 || pos + 2 * n * sizeof(uint64_t) > size)
+    return false;
+  r.leafProfile.reserve(n);
+  r.nodeProfile.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    getRaw(data, size, pos, c);
+    r.leafProfile.push_back(c);
+  }
+  for (int i = 0; i < n; ++i) {
+    getRaw(data, size, pos, c);
+    r.nodeProfile.push_back(c);
+  }
+
+  if (!getRaw(data, size, pos, n) || n < 0 || pos + n * sizeof(uint8_t) > size)
+    return false;
+  r.open.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    uint8_t f;
+    getRaw(data, size, pos, f);
+    r.open.push_back(f != 0);
+  }
+
+  return pos == size;
+}
+
+
+bool ResultLog::append(const string& path, const SubproblemResult& r) {
+  string record;
+  encode(r, record);
+#if defined(WINDOWS)
+  ofstream out(path.c_str(), ios::out | ios::app | ios::binary);
+  out.write(record.data(), record.size());
+  out.close();
+  return !out.fail();
+#else
+  int fd = open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+  if (fd < 0)
+    return false;
+  size_t done = 0;
+  while (done < record.size()) {
+    ssize_t w = write(fd, record.data() + done, record.size() - done);
+    if (w < 0 && errno == EINTR)
+      continue;
+    if (w <= 0)
+      break;
+    done += w;
+  }
+  close(fd);
+  return done == record.size();
+#endif
+}
+
+
+void ResultReader::feed(const char* data, size_t size) {
+  // drop consumed records first, to keep the buffer small
+  if (m_pos > 0 && m_pos >= m_buffer.size() / 2) {
+    m_buffer.erase(0, m_pos);
+    m_pos = 0;
+  }
+  m_buffer.append(data, size);
+}
+
+
+bool ResultReader::next(SubproblemResult& r) {
+  while (!m_error) {
+    if (m_buffer.size() - m_pos < RESULT_HEADER_SIZE)
+      return false;
+    const char* head = m_buffer.data() + m_pos;
+    size_t pos = 0;
+    uint32_t magic = 0, size = 0;
+    uint16_t version = 0, reserved = 0;
+    getRaw(head, RESULT_HEADER_SIZE, pos, magic);
+    getRaw(head, RESULT_HEADER_SIZE, pos, version);
+    getRaw(head, RESULT_HEADER_SIZE, pos, reserved);
+    getRaw(head, RESULT_HEADER_SIZE, pos, size);
+    if (magic != RESULT_MAGIC) {
+      m_error = true;
+      return false;
+    }
+    if (m_buffer.size() - m_pos - RESULT_HEADER_SIZE < size)
+      return false;  // incomplete, wait for more data
+
+    m_pos += RESULT_HEADER_SIZE + size;
+    if (version != RESULT_VERSION) {
+      ++m_skipped;  // newer format, skip it
+      continue;
+    }
+    if (!ResultLog::decode(head + RESULT_HEADER_SIZE, size, r)) {
+      m_error = true;
+      return false;
+    }
+    return true;
+  }
+  return false;
+}
+
+
+bool ResultReader::readFile(const string& path, vector<SubproblemResult>& out) {
+  ifstream in(path.c_str(), ios::in | ios::binary);
+  if (!in)
+    return false;
+  ResultReader reader;
+  SubproblemResult r;
+  char buf[65536];
+  while (in) {
+    in.read(buf, sizeof(buf));
+    reader.feed(buf, in.gcount());
+    while (reader.next(r))
+      out.push_back(r);
+  }
+  return !reader.error() && !reader.pending();
+}
+
+}  // namespace daoopt
@@ -26,10 +26,20 @@
 
 namespace daoopt {
 
-bool SLSWrapper::init(Problem* prob, int iter, int time) {
+bool SLSWrapper::init(Problem* prob, int iter, int time, int threads) {
 
   assert(prob);
   m_problem = prob;
+  m_numVars = prob->getN() - ((prob->hasDummy()) ? 1 : 0);  // -1 for dummy variable
+  m_iter = iter;
+  m_time = time;
+  m_threads = max(1, min(threads, iter));
+
+  return true;
+}
+
+
+void SLSWrapper::load() {
 
   sls4mpe::verbose = false;
   sls4mpe::start_timer();
@@ -43,23 +53,22 @@ bool SLSWrapper::init(Problem* prob, int iter, int time) {
   sls4mpe::sls_filename[0] = '\0';
   //strncpy(sls4mpe::network_filename, filename.c_str(), filename.size());
 
-  sls4mpe::maxRuns = iter;
-  sls4mpe::maxTime = time;
+  sls4mpe::maxTime = m_time;
 
   sls4mpe::preprocessingSizeBound = 0;
 
   sls4mpe::slsWrapper = this;
 
   // load network directly into SLS from Problem*
-  sls4mpe::num_vars = prob->getN() - ((prob->hasDummy()) ? 1 : 0);  // -1 for dummy variable
-  sls4mpe::num_pots = prob->getC();
+  sls4mpe::num_vars = m_numVars;
+  sls4mpe::num_pots = m_problem->getC();
   sls4mpe::allocateVarsAndPTs(false);
 
   for (int i=0; i < sls4mpe::num_vars; ++i)
-    sls4mpe::variables[i]->setDomainSize(prob->getDomainSize(i));
+    sls4mpe::variables[i]->setDomainSize(m_problem->getDomainSize(i));
 
-  for (int i=0; i < prob->getC(); ++i) {
-    Function* fn = prob->getFunctions().at(i);
+  for (int i=0; i < m_problem->getC(); ++i) {
+    Function* fn = m_problem->getFunctions().at(i);
 
     sls4mpe::probTables[i]->init(fn->getArity());
     int j = 0;
@@ -76,12 +85,23 @@ bool SLSWrapper::init(Problem* prob, int iter, int time) {
 #endif
     }
   }
-
-  return true;
 }
 
 
 void SLSWrapper::reportSolution(double cost, int num_vars, int* assignment) {
+#ifndef NOTHREADS
+  boost::mutex::scoped_lock lock(m_mtx);  // SLS instances may run in parallel
+  if (m_live) {  // hand over to the search thread, see poll()
+    m_liveCost = cost;
+#ifndef NO_ASSIGNMENT
+    m_liveSolution.assign(assignment, assignment + num_vars);
+#endif
+    return;
+  }
+#endif
+  double cur = m_problem->getSolutionCost();
+  if (!ISNAN(cur) && cost <= cur + sls4mpe::EPS)
+    return;  // another instance found a better one already
 #ifndef NO_ASSIGNMENT
   cost += sls4mpe::EPS;  // EPS needed to avoid floating point precision issues
   assert(assignment);
@@ -96,18 +116,107 @@ void SLSWrapper::reportSolution(double cost, int num_vars, int* assignment) {
 
 
 bool SLSWrapper::run() {
-  m_assignment = new int[sls4mpe::num_vars];
+#ifndef NOTHREADS
+  if (m_threads > 1) {
+    boost::thread_group group;
+    for (int i = 0; i < m_threads; ++i)
+      group.create_thread(SLSRestartThread(this, i));
+    group.join_all();
+    return true;
+  }
+#endif
+  this->work(0);
+  return true;
+}
+
+
+void SLSWrapper::work(int i) {
+  load();
+  // restarts are split evenly, each instance with its own random seed
+  sls4mpe::maxRuns = m_iter / m_threads + ((i < m_iter % m_threads) ? 1 : 0);
+  sls4mpe::initialSeed = 1 + i;
+
+  int* assignment = new int[m_numVars];
+  double likelihood = 0.0;
   sls4mpe::start_timer();
-  sls4mpe::runAlgorithm(&m_assignment, &m_likelihood);
+  sls4mpe::runAlgorithm(&assignment, &likelihood);
   sls4mpe::deallocateVarsAndPTs(false);
+
+  {
+#ifndef NOTHREADS
+    boost::mutex::scoped_lock lock(m_mtx);
+#endif
+    if (!m_assignment || likelihood > m_likelihood) {
+      swap(assignment, m_assignment);
+      m_likelihood = likelihood;
+    }
+    m_flips += sls4mpe::totalFlips;
+    m_flipTime += sls4mpe::totalFlipTime;
+  }
+  delete[] assignment;
+}
+
+#ifndef NOTHREADS
+void SLSWrapper::start() {
+  m_live = true;
+  m_stop = false;
+  m_thread.reset(new boost::thread(SLSThread(this)));
+}
+
+
+void SLSWrapper::stop() {
+  if (!m_thread)
+    return;
+  m_stop = true;
+  m_thread->join();
+  m_thread.reset();
+}
+
+
+bool SLSWrapper::poll(double bound, double& cost, vector<val_t>& tuple) {
+  boost::mutex::scoped_lock lock(m_mtx);
+  if (ISNAN(m_liveCost))
+    return false;
+  cost = m_liveCost;
+  m_liveCost = ELEM_NAN;
+  if (!ISNAN(bound) && cost <= bound + sls4mpe::EPS)
+    return false;  // search found a better one in the meantime
+  cost += sls4mpe::EPS;  // as in reportSolution()
+  tuple.swap(m_liveSolution);
   return true;
 }
 
+
+void SLSWrapper::restartFrom(const vector<val_t>& tuple) {
+  boost::mutex::scoped_lock lock(m_mtx);
+  m_restart.assign(tuple.begin(), tuple.end());
+}
+
+
+#endif
+
+
+bool SLSWrapper::getRestart(int* values, int num_vars) {
+#ifndef NOTHREADS
+  boost::mutex::scoped_lock lock(m_mtx);
+#endif
+  if ((int) m_restart.size() < num_vars)
+    return false;
+  copy(m_restart.begin(), m_restart.begin() + num_vars, values);
+  m_restart.clear();
+  return true;
+}
+
+long SLSWrapper::getFlipStats(double& rate) const {
+  rate = (m_flipTime > 0) ? m_flips / m_flipTime : 0.0;
+  return m_flips;
+}
+
 double SLSWrapper::getSolution(vector<val_t>* tuple) const {
   if (tuple) {
     tuple->clear();
-    tuple->resize(sls4mpe::num_vars);
-    for (int i=0; i<sls4mpe::num_vars; ++i) {
+    tuple->resize(m_numVars);
+    for (int i=0; i<m_numVars; ++i) {
       tuple->at(i) = m_assignment[i];
     }
   }
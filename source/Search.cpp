@@ -33,6 +33,7 @@ Search::Search(Problem* prob, Pseudotree* pt, SearchSpace* s, Heuristic* h) :
 #ifdef PARALLEL_DYNAMIC
   , m_nextSubprob(NULL)
 #endif
+  , m_boundUpdated(false), m_pstRootInit(ELEM_NAN)
 {
   // initialize the array for counting nodes per level
   m_nodeProfile.resize(m_pseudotree->getHeight()+1, 0);
@@ -44,6 +45,10 @@ Search::Search(Problem* prob, Pseudotree* pt, SearchSpace* s, Heuristic* h) :
 
   // Preallocate space for expansion vector. 128 should be plenty.
   m_expand.reserve(128);
+
+  // set up forward checking on deterministic functions
+  if (!m_space->options || !m_space->options->nofwdcheck)
+    this->initForwardChecking();
 }
 
 
@@ -68,6 +73,13 @@ void Search::finalizeHeuristic() {
   assert(m_space && m_space->getTrueRoot());
 
   SearchNode* root = m_space->getTrueRoot();
+  if (m_space->subproblemLocal) {
+    // conditioned subproblem, root is a regular OR node: precompute its
+    // heuristic and child labels under the context assignment
+    assignCostsOR(root);
+    this->reset(root);
+    return;
+  }
   root->setHeur(m_heuristic->getGlobalUB());
 
   SearchNode* next = new SearchNodeAND(root, 0, m_problem->globalConstInfo());
@@ -169,6 +181,8 @@ bool Search::doPruning(SearchNode* node) {
     DIAG( myprint("\t !pruning \n") );
     node->setLeaf();
     m_space->stats.numPruned += 1;
+    if (m_boundUpdated && prunedByUpdate(node))
+      m_space->stats.numPrunedBound += 1;
     node->setPruned();
     if (node->getType() == NODE_AND) {
       // count 1 leaf AND node
@@ -256,6 +270,78 @@ bool Search::canBePruned(SearchNode* n) const {
 } // Search::canBePruned
 
 
+void Search::initForwardChecking() {
+  int n = m_problem->getN();
+  m_fcFunctions.clear();
+  m_fcFunctions.resize(n);
+  m_fcChecks.clear();
+  m_fcChecks.resize(n);
+
+  vector<pair<int, pair<int, Function*> > > funs; // <depth, <var, function> >
+  for (int y = 0; y < n; ++y) {
+    PseudotreeNode* ptnode = m_pseudotree->getNode(y);
+    if (!ptnode) continue;
+    int depthY = ptnode->getDepth();
+
+    // collect the functions with zero entries, indexed by their trigger variable,
+    // i.e. the deepest scope variable other than y
+    funs.clear();
+    const vector<Function*>& bucket = ptnode->getFunctions();
+    for (vector<Function*>::const_iterator it = bucket.begin(); it != bucket.end(); ++it) {
+      if ((*it)->getArity() < 2 || (*it)->getTightness() == (*it)->getTableSize())
+        continue;
+      int trigger = NONE, depthT = NONE;
+      for (vector<int>::const_iterator itS = (*it)->getScopeVec().begin();
+           itS != (*it)->getScopeVec().end(); ++itS) {
+        if (*itS == y) continue;
+        int d = m_pseudotree->getNode(*itS)->getDepth();
+        if (d > depthT) { depthT = d; trigger = *itS; }
+      }
+      funs.push_back(make_pair(depthT, make_pair(trigger, *it)));
+    }
+    if (funs.empty()) continue;
+    stable_sort(funs.begin(), funs.end());
+
+    for (size_t i = 0; i < funs.size(); ++i) {
+      m_fcFunctions[y].push_back(funs[i].second.second);
+      // register check with trigger variable after its last function, but skip the
+      // parent variable (covered by the label computation of the child OR node)
+      bool last = (i+1 == funs.size() || funs[i+1].first != funs[i].first);
+      if (last && funs[i].first < depthY - 1)
+        m_fcChecks[funs[i].second.first].push_back(make_pair(y, i+1));
+    }
+  }
+}
+
+
+bool Search::forwardCheck(int var) {
+  if (var >= (int) m_fcChecks.size())
+    return false;
+
+  const vector<pair<int,size_t> >& checks = m_fcChecks[var];
+  for (vector<pair<int,size_t> >::const_iterator it = checks.begin(); it != checks.end(); ++it) {
+    int y = it->first;
+    const vector<Function*>& funs = m_fcFunctions[y];
+    val_t old = m_assignment[y];
+    bool supported = false;
+    for (val_t i = 0; i < m_problem->getDomainSize(y) && !supported; ++i) {
+      m_assignment[y] = i;
+      supported = true;
+      for (size_t k = 0; k < it->second; ++k) {
+        if (funs[k]->getValue(m_assignment) == ELEM_ZERO) {
+          supported = false;
+          break;
+        }
+      }
+    }
+    m_assignment[y] = old;
+    if (!supported)
+      return true; // no value left for y
+  }
+  return false; // default, no wipe-out
+}
+
+
 void Search::syncAssignment(const SearchNode* node) {
   // only accept OR nodes
   assert(node && node->getType()==NODE_OR);
@@ -295,6 +381,19 @@ bool Search::generateChildrenAND(SearchNode* n, vector<SearchNode*>& chi) {
 #endif
   if (depth>=0) m_nodeProfile[depth] +=1; // ignores dummy node
 
+  // check deeper variables for domain wipe-outs caused by the current assignment
+  if (forwardCheck(var)) {
+    DIAG( myprint("\t !wipe-out\n") );
+    n->setLeaf();
+    n->setValue(ELEM_ZERO);
+    m_space->stats.numDead += 1;
+    if (depth!=-1) m_leafProfile[depth] += 1;
+#if defined PARALLEL_DYNAMIC
+    n->setSubLeaves(1);
+#endif
+    return true;
+  }
+
   // create new OR children (going in reverse due to reversal on stack)
   for (vector<PseudotreeNode*>::const_reverse_iterator it=ptnode->getChildren().rbegin();
        it!=ptnode->getChildren().rend(); ++it)
@@ -551,6 +650,17 @@ double Search::lowerBound(const SearchNode* node) const {
 }
 
 
+bool Search::prunedByUpdate(SearchNode* n) const {
+  // check again with the original PST root value
+  SearchNode* root = m_space->root;
+  double bound = root->getValue();
+  root->setValue(m_pstRootInit);
+  bool res = !canBePruned(n);
+  root->setValue(bound);
+  return res;
+}
+
+
 bool Search::loadInitialBound(string file) {
 
   // See if file can be opened
@@ -638,10 +748,11 @@ int Search::restrictSubproblem(int rootVar, const vector<val_t>& assig, const ve
   // resize node count vectors for subproblem
   m_nodeProfile.clear();
   m_nodeProfile.resize(m_pseudotree->getHeightCond()+1);
-  m_nodeProfile.clear();
+  m_leafProfile.clear();
   m_leafProfile.resize(m_pseudotree->getHeightCond()+1);
   // reset search stats
   m_space->stats = SearchStats();
+  m_boundUpdated = false;
 
   // set context assignment
   const vector<int>& context = m_pseudotree->getNode(rootVar)->getFullContextVec();
@@ -685,6 +796,49 @@ int Search::restrictSubproblem(int rootVar, const vector<val_t>& assig, const ve
 }
 
 
+void Search::addProfiles(const vector<count_t>& nodeP, const vector<count_t>& leafP, int depth) {
+  for (size_t d = 0; d < nodeP.size() && depth + d < m_nodeProfile.size(); ++d) {
+    m_nodeProfile[depth + d] += nodeP[d];
+    m_leafProfile[depth + d] += leafP[d];
+  }
+}
+
+
+bool Search::updateGlobalBound(double d) {
+  assert(m_space && m_space->root);
+  if (!m_space->subproblemLocal || ISNAN(d))
+    return false;  // not a conditioned subproblem
+  SearchNode* root = m_space->root;  // top of parent PST
+  double cur = root->getValue();
+  if (!ISNAN(cur) && d <= cur)
+    return false;
+  if (!m_boundUpdated) {
+    m_pstRootInit = cur;
+    m_boundUpdated = true;
+  }
+  root->setValue(d);
+  return true;
+}
+
+
+bool Search::getOpenRootValues(vector<bool>& open) const {
+  const SearchNode* root = m_space->subproblemLocal;
+  if (!root)
+    return false;
+  int var = root->getVar();
+  NodeP* children = root->getChildren();
+  // solved AND children have been erased from the root by now
+  open.assign(m_problem->getDomainSize(var), (children == NULL));
+  if (children) {
+    for (size_t i = 0; i < root->getChildCountFull(); ++i) {
+      if (children[i])
+        open.at(children[i]->getVal()) = true;
+    }
+  }
+  return true;
+}
+
+
 bool Search::updateSolution(double d
 #ifndef NO_ASSIGNMENT
     ,const vector<val_t>& tuple
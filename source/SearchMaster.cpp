@@ -109,18 +109,26 @@ void SearchMaster::operator ()() {
       }
 
       if ( node->isLeaf() ) { // leaf node, straight to propagation queue
-        GETLOCK(m_spaceMaster->mtx_solved, lk2);
         m_spaceMaster->leaves.push(node);
-        m_spaceMaster->cond_solved.notify_one();
+        m_spaceMaster->notifySolved();
       } else if ( node->isExtern() ) {
 
         // Create new process that 'outsources' subproblem solving, collects the
         // results and feeds it back into the search space
-        SubproblemCondor subprob(m_spaceMaster, m_nextSubprob, m_nextThreadId);
+        // (thread is registered before it can report back to the propagation)
         {
           GETLOCK(m_spaceMaster->mtx_activeThreads, lk2);
-          m_spaceMaster->activeThreads.insert(
-              make_pair( m_nextSubprob , new boost::thread(subprob) )  );
+          boost::thread* tp = NULL;
+          if (m_spaceMaster->options->par_threaded) {
+            // solve in a local thread instead (copies the current assignment)
+            SubproblemThread subprob(m_spaceMaster, m_nextSubprob, m_nextThreadId,
+                                     m_problem, m_pseudotree, m_heuristic, m_assignment);
+            tp = new boost::thread(subprob);
+          } else {
+            SubproblemCondor subprob(m_spaceMaster, m_nextSubprob, m_nextThreadId);
+            tp = new boost::thread(subprob);
+          }
+          m_spaceMaster->activeThreads.insert( make_pair( m_nextSubprob , tp ) );
         }
         m_nextSubprob = NULL;
         m_nextThreadId += 1;
@@ -176,11 +176,8 @@ void SubproblemCondor::operator() () {
   // clean up pointers
   if (waitProc) delete waitProc;
 
-  {
-    GETLOCK(m_spaceMaster->mtx_solved, lk);
-    m_spaceMaster->solved.push(m_subproblem); // push node to solved queue
-    m_spaceMaster->cond_solved.notify_one();
-  }
+  m_spaceMaster->solved.push(m_subproblem); // push node to solved queue
+  m_spaceMaster->notifySolved();
 
 }
 
@@ -543,6 +540,8 @@ string CondorSubmissionEngine::encodeJob(CondorSubmission* P) {
   command << " -c " << solutionFile.str();
   command << " -r " << m_spaceMaster->options->subprobOrder;
   command << " -t 0";
+  if (!m_spaceMaster->boundFile.empty())
+    command << " --bound-updates " << m_spaceMaster->boundFile;
   //command << " > /dev/null";
 
   // Add command line arguments to condor job
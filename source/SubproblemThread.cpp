@@ -0,0 +1,102 @@
+/*
+ * SubproblemThread.cpp
+ *
+ *  Copyright (C) 2008-2012 Lars Otten
+ *  This file is part of DAOOPT.
+ *
+ *  DAOOPT is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  DAOOPT is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with DAOOPT.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Lars Otten <lotten@ics.uci.edu>
+ */
+
+#include "SubproblemThread.h"
+
+#ifdef PARALLEL_DYNAMIC
+
+#include "BranchAndBound.h"
+#include "BoundPropagator.h"
+#include "BoundChannel.h"
+
+namespace daoopt {
+
+void SubproblemThread::operator() () {
+
+  try {
+
+  // restricting modifies the pseudo tree, so work on a copy
+  Pseudotree pt(*m_pseudotree);
+  SearchSpace space(&pt, m_spaceMaster->options);
+  BranchAndBound bab(m_problem, &pt, &space, m_heuristic);
+  bab.restrictSubproblem(m_rootnode->getVar(), m_assignment, m_pst);
+#ifndef NO_HEURISTIC
+  bab.finalizeHeuristic();
+#endif
+
+  // no solution reporting, the problem instance is shared
+  BoundPropagator prop(m_problem, &space, !m_spaceMaster->options->nocaching);
+  size_t updates = 0;
+  SearchNode* n = bab.nextLeaf();
+  for (count_t leaves = 0; n; ++leaves) {
+    prop.propagate(n);
+    boost::this_thread::interruption_point();
+    if (leaves % BOUND_POLL_INTERVAL == 0) {  // poll global bound from master
+      double bound;
+      {
+        GETLOCK(m_spaceMaster->mtx_bound, lk);
+        bound = m_spaceMaster->globalBound;
+      }
+      if (bab.updateGlobalBound(bound))
+        ++updates;
+    }
+    n = bab.nextLeaf();
+  }
+
+  double optCost = bab.getCurOptValue();
+
+  // Write subproblem solution value and tuple into search node
+  m_subproblem->root->setValue(optCost);
+#ifndef NO_ASSIGNMENT
+  m_subproblem->root->setOptAssig(bab.getCurOptTuple());
+#endif
+  // Write number of OR/AND nodes and profiles into subproblem
+  m_subproblem->nodesOR = space.stats.numExpOR;
+  m_subproblem->nodesAND = space.stats.numExpAND;
+  m_subproblem->leafP = bab.getLeafProfile();
+  m_subproblem->nodeP = bab.getNodeProfile();
+  // Mark as solved
+  m_subproblem->setSolved();
+
+  ostringstream ss;
+  ss << "<-- Subproblem " << m_threadId << " (local): "
+     << optCost << "|" << m_subproblem->upperBound
+     << " (" << m_subproblem->nodesAND << '/' << m_subproblem->estimate << '/' << m_subproblem->hwb
+     << ", w=" << m_subproblem->width << ")";
+  if (updates)
+    ss << " bound updates: " << updates << ", pruned: " << space.stats.numPrunedBound;
+  ss << '\n';
+  myprint(ss.str());
+
+  } catch (boost::thread_interrupted i) {
+    // intentionally left empty, subproblem stays unsolved
+  }
+
+  m_spaceMaster->solved.push(m_subproblem); // push node to solved queue
+  m_spaceMaster->notifySolved();
+
+}
+
+}  // namespace daoopt
+
+#endif /* PARALLEL_DYNAMIC */